@@ -29,6 +29,21 @@ HEADERS    += src/widget/fluentcardwidget.h \
               # Future widgets:
               # src/widget/fluentmetricwidget.h \
 
+# Widget support headers
+HEADERS    += src/widget/fluentchartdecimator.h \
+              src/widget/fluentlodpyramid.h \
+              src/widget/fluentgraphrenderer.h \
+              src/widget/fluentseriestable.h \
+              src/widget/fluenthittestindex.h \
+              src/widget/fluentmappedseriesfile.h \
+              src/widget/fluentcsvreader.h \
+              src/widget/fluentseriesstore.h \
+              src/widget/fluentseriesoverlay.h \
+              src/widget/fluentserieskernels.h \
+              src/widget/fluentreorderbuffer.h \
+              src/widget/fluenttopnselector.h \
+              src/widget/fluentperf.h
+
 # Plugin Sources
 SOURCES     = src/plugin/fluentwidgetsplugin.cpp \
               src/plugin/fluentcardwidgetplugin.cpp \
@@ -55,6 +70,21 @@ SOURCES    += src/widget/fluentcardwidget.cpp \
               # Future widgets:
               # src/widget/fluentmetricwidget.cpp \
 
+# Widget support sources
+SOURCES    += src/widget/fluentchartdecimator.cpp \
+              src/widget/fluentlodpyramid.cpp \
+              src/widget/fluentgraphrenderer.cpp \
+              src/widget/fluentseriestable.cpp \
+              src/widget/fluenthittestindex.cpp \
+              src/widget/fluentmappedseriesfile.cpp \
+              src/widget/fluentcsvreader.cpp \
+              src/widget/fluentseriesstore.cpp \
+              src/widget/fluentseriesoverlay.cpp \
+              src/widget/fluentserieskernels.cpp \
+              src/widget/fluentreorderbuffer.cpp \
+              src/widget/fluenttopnselector.cpp \
+              src/widget/fluentperf.cpp
+
 # Resources
 RESOURCES   = resources/icons.qrc
 
@@ -66,7 +96,21 @@ INCLUDEPATH += src/widget \
 # Qt modules
 QT += designer \
       widgets \
-      charts
+      concurrent
+
+# Graph cards fall back to their QPainter backend without Qt Charts
+# (qmake CONFIG+=fluentwidget_no_qtcharts)
+fluentwidget_no_qtcharts {
+    DEFINES += FLUENTWIDGET_NO_QTCHARTS
+} else {
+    QT += charts
+}
+
+# Widgets count and time their costly operations through FluentPerf
+# (qmake CONFIG+=fluentwidget_perf)
+fluentwidget_perf {
+    DEFINES += FLUENTWIDGET_PERF
+}
 
 # Installation
 target.path = $$[QT_INSTALL_PLUGINS]/designer
@@ -0,0 +1,339 @@
+// FluentWidgetBench - QtTest benchmarks for the Fluent widgets
+//
+// Build with -DBUILD_BENCHMARKS=ON and run offscreen, e.g.
+//   QT_QPA_PLATFORM=offscreen ./FluentWidgetBench
+// For results to compare between releases, write them as XML or CSV:
+//   QT_QPA_PLATFORM=offscreen ./FluentWidgetBench -o results.xml,xml
+//   QT_QPA_PLATFORM=offscreen ./FluentWidgetBench -o results.csv,csv
+#include <QtTest>
+#include <QAbstractTableModel>
+
+#include "fluentgraphcardwidget.h"
+
+#include <cmath>
+
+namespace {
+
+// A category and a value per row, computed when asked for, so a million
+// rows take no memory of their own
+class BenchModel : public QAbstractTableModel
+{
+public:
+    explicit BenchModel(int rows, QObject *parent = nullptr)
+        : QAbstractTableModel(parent)
+        , m_rows(rows)
+    {
+    }
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override
+    {
+        return parent.isValid() ? 0 : m_rows;
+    }
+
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override
+    {
+        return parent.isValid() ? 0 : 2;
+    }
+
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override
+    {
+        if (!index.isValid() || role != Qt::DisplayRole) return QVariant();
+        if (index.column() == 0) return QStringLiteral("C%1").arg(index.row());
+        return 50.0 + 40.0 * std::sin(index.row() * 0.01) + index.row() % 7;
+    }
+
+private:
+    int m_rows;
+};
+
+} // namespace
+
+class FluentWidgetBench : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Construction
+    void constructGraphCard_data();
+    void constructGraphCard();
+    void showGraphCard_data();
+    void showGraphCard();
+
+    // Every backend, chart type and data size
+    void loadDataFromModel_data();
+    void loadDataFromModel();
+    void refreshChart_data();
+    void refreshChart();
+    void switchGraphType_data();
+    void switchGraphType();
+    void hoverHitTest_data();
+    void hoverHitTest();
+    void paintFrame_data();
+    void paintFrame();
+
+private:
+    static void addRenderBackendRows();
+    static void addChartRows();
+    static bool isImpractical(int backend, int graphType, int points);
+    static bool setUpCard(FluentGraphCardWidget *card, QAbstractItemModel *model);
+    static void flushRefresh(FluentGraphCardWidget *card);
+};
+
+void FluentWidgetBench::addRenderBackendRows()
+{
+    QTest::addColumn<int>("backend");
+
+#ifndef FLUENTWIDGET_NO_QTCHARTS
+    QTest::newRow("QtCharts") << int(FluentGraphCardWidget::QtChartsBackend);
+#endif
+    QTest::newRow("Raster") << int(FluentGraphCardWidget::RasterBackend);
+}
+
+void FluentWidgetBench::addChartRows()
+{
+    QTest::addColumn<int>("backend");
+    QTest::addColumn<int>("graphType");
+    QTest::addColumn<int>("points");
+
+    QList<QPair<QString, int>> backends;
+#ifndef FLUENTWIDGET_NO_QTCHARTS
+    backends.append(qMakePair(QStringLiteral("QtCharts"), int(FluentGraphCardWidget::QtChartsBackend)));
+#endif
+    backends.append(qMakePair(QStringLiteral("Raster"), int(FluentGraphCardWidget::RasterBackend)));
+
+    const QList<QPair<QString, int>> sizes = {
+        qMakePair(QStringLiteral("1k"), 1000),
+        qMakePair(QStringLiteral("100k"), 100000),
+        qMakePair(QStringLiteral("1M"), 1000000)
+    };
+
+    const QMetaObject &metaObject = FluentGraphCardWidget::staticMetaObject;
+    const QMetaEnum graphTypes = metaObject.enumerator(metaObject.indexOfEnumerator("GraphType"));
+
+    for (const QPair<QString, int> &backend : backends) {
+        for (int i = 0; i < graphTypes.keyCount(); ++i) {
+            for (const QPair<QString, int> &size : sizes) {
+                const QString name = backend.first + QLatin1Char('/') + QLatin1String(graphTypes.key(i))
+                                     + QLatin1Char('/') + size.first;
+                QTest::newRow(qPrintable(name)) << backend.second << graphTypes.value(i) << size.second;
+            }
+        }
+    }
+}
+
+bool FluentWidgetBench::isImpractical(int backend, int graphType, int points)
+{
+    // Qt Charts bar charts are not decimated; past this they only measure
+    // the layout of the bar set
+    return backend == FluentGraphCardWidget::QtChartsBackend
+           && graphType == FluentGraphCardWidget::BarChart && points > 100000;
+}
+
+bool FluentWidgetBench::setUpCard(FluentGraphCardWidget *card, QAbstractItemModel *model)
+{
+    // Shown at a fixed size with the model loaded and the chart built; pies
+    // keep to a dozen slices, as a pie of every row draws nothing useful
+    QFETCH(int, backend);
+    QFETCH(int, graphType);
+
+    card->setRenderBackend(FluentGraphCardWidget::RenderBackend(backend));
+    card->setGraphType(FluentGraphCardWidget::GraphType(graphType));
+    card->setAnimated(false);
+    card->setMaxSlices(12);
+    card->resize(640, 400);
+    card->setDataModel(model);
+    card->setXColumn(0);
+    card->setYColumns({1});
+    card->loadDataFromModel();
+    card->show();
+    if (!QTest::qWaitForWindowExposed(card)) return false;
+
+    flushRefresh(card);
+    return true;
+}
+
+void FluentWidgetBench::flushRefresh(FluentGraphCardWidget *card)
+{
+    // Applies the pending refresh now instead of on a timer, so only the
+    // chart update is measured
+    QMetaObject::invokeMethod(card, "flushRefresh", Qt::DirectConnection);
+}
+
+void FluentWidgetBench::constructGraphCard_data()
+{
+    addRenderBackendRows();
+}
+
+void FluentWidgetBench::constructGraphCard()
+{
+    // Per-card cost of creating a card that is never shown: no chart is built
+    QFETCH(int, backend);
+
+    QBENCHMARK {
+        FluentGraphCardWidget card;
+        card.setRenderBackend(FluentGraphCardWidget::RenderBackend(backend));
+    }
+}
+
+void FluentWidgetBench::showGraphCard_data()
+{
+    addRenderBackendRows();
+}
+
+void FluentWidgetBench::showGraphCard()
+{
+    // Creating and showing a card, which builds its chart exactly once
+    QFETCH(int, backend);
+
+    QBENCHMARK {
+        FluentGraphCardWidget card;
+        card.setRenderBackend(FluentGraphCardWidget::RenderBackend(backend));
+        card.show();
+    }
+}
+
+void FluentWidgetBench::loadDataFromModel_data()
+{
+    addChartRows();
+}
+
+void FluentWidgetBench::loadDataFromModel()
+{
+    // Copying the model cells into the series; the chart update it
+    // schedules is measured by refreshChart
+    QFETCH(int, backend);
+    QFETCH(int, graphType);
+    QFETCH(int, points);
+    if (isImpractical(backend, graphType, points)) {
+        QSKIP("Qt Charts lays out every bar of a set");
+    }
+
+    BenchModel model(points);
+    FluentGraphCardWidget card;
+    QVERIFY(setUpCard(&card, &model));
+
+    QBENCHMARK {
+        card.loadDataFromModel();
+    }
+}
+
+void FluentWidgetBench::refreshChart_data()
+{
+    addChartRows();
+}
+
+void FluentWidgetBench::refreshChart()
+{
+    // One full chart update from unchanged data
+    QFETCH(int, backend);
+    QFETCH(int, graphType);
+    QFETCH(int, points);
+    if (isImpractical(backend, graphType, points)) {
+        QSKIP("Qt Charts lays out every bar of a set");
+    }
+
+    BenchModel model(points);
+    FluentGraphCardWidget card;
+    QVERIFY(setUpCard(&card, &model));
+
+    QBENCHMARK {
+        card.refreshChart();
+        flushRefresh(&card);
+    }
+}
+
+void FluentWidgetBench::switchGraphType_data()
+{
+    addChartRows();
+}
+
+void FluentWidgetBench::switchGraphType()
+{
+    // Away to the next chart type and back, each switch applied at once
+    QFETCH(int, backend);
+    QFETCH(int, graphType);
+    QFETCH(int, points);
+    const int other = (graphType + 1) % (FluentGraphCardWidget::AreaChart + 1);
+    if (isImpractical(backend, graphType, points) || isImpractical(backend, other, points)) {
+        QSKIP("Qt Charts lays out every bar of a set");
+    }
+
+    BenchModel model(points);
+    FluentGraphCardWidget card;
+    QVERIFY(setUpCard(&card, &model));
+
+    QBENCHMARK {
+        card.setGraphType(FluentGraphCardWidget::GraphType(other));
+        flushRefresh(&card);
+        card.setGraphType(FluentGraphCardWidget::GraphType(graphType));
+        flushRefresh(&card);
+    }
+}
+
+void FluentWidgetBench::hoverHitTest_data()
+{
+    addChartRows();
+}
+
+void FluentWidgetBench::hoverHitTest()
+{
+    // A mouse move over the plot, finding the nearest point; the positions
+    // sweep across the card so every move lands somewhere new
+    QFETCH(int, backend);
+    QFETCH(int, graphType);
+    QFETCH(int, points);
+    if (isImpractical(backend, graphType, points)) {
+        QSKIP("Qt Charts lays out every bar of a set");
+    }
+
+    BenchModel model(points);
+    FluentGraphCardWidget card;
+    QVERIFY(setUpCard(&card, &model));
+
+    QList<QPointF> positions;
+    for (int i = 0; i < 64; ++i) {
+        positions.append(QPointF(card.width() * (i + 0.5) / 64, card.height() / 2.0));
+    }
+
+    // The first move builds the hit-test index
+    QTest::mouseMove(&card, positions.first().toPoint());
+
+    int next = 0;
+    QBENCHMARK {
+        const QPointF position = positions.at(next++ % positions.size());
+        QMouseEvent move(QEvent::MouseMove, position, card.mapToGlobal(position),
+                         Qt::NoButton, Qt::NoButton, Qt::NoModifier);
+        QCoreApplication::sendEvent(&card, &move);
+    }
+}
+
+void FluentWidgetBench::paintFrame_data()
+{
+    addChartRows();
+}
+
+void FluentWidgetBench::paintFrame()
+{
+    // Painting the card with the plot rendered afresh, not blitted from
+    // the plot cache
+    QFETCH(int, backend);
+    QFETCH(int, graphType);
+    QFETCH(int, points);
+    if (isImpractical(backend, graphType, points)) {
+        QSKIP("Qt Charts lays out every bar of a set");
+    }
+
+    BenchModel model(points);
+    FluentGraphCardWidget card;
+    QVERIFY(setUpCard(&card, &model));
+
+    QBENCHMARK {
+        QMetaObject::invokeMethod(&card, "invalidatePlotCache", Qt::DirectConnection);
+        const QPixmap frame = card.grab();
+        Q_UNUSED(frame);
+    }
+}
+
+QTEST_MAIN(FluentWidgetBench)
+
+#include "fluentwidgetbench.moc"
@@ -1,4 +1,5 @@
 #include "fluentbuttonwidget.h"
+#include "fluentperf.h"
 #include <QApplication>
 #include <QPalette>
 #include <QFontMetrics>
@@ -39,11 +40,13 @@ void FluentButtonWidget::setupAnimations()
 {
     // Hover animation
     m_hoverAnimation = new QPropertyAnimation(this, "geometry", this);
+    FLUENT_PERF_ANIMATION(m_hoverAnimation);
     m_hoverAnimation->setDuration(150);
     m_hoverAnimation->setEasingCurve(QEasingCurve::OutCubic);
 
     // Press animation
     m_pressAnimation = new QPropertyAnimation(this, "geometry", this);
+    FLUENT_PERF_ANIMATION(m_pressAnimation);
     m_pressAnimation->setDuration(100);
     m_pressAnimation->setEasingCurve(QEasingCurve::OutCubic);
 
@@ -62,6 +65,7 @@ void FluentButtonWidget::setupAnimations()
 
 void FluentButtonWidget::updateStyles()
 {
+    FLUENT_PERF_SCOPE(StyleUpdate);
     QString styleSheet = getStyleSheet();
     setStyleSheet(styleSheet);
 
@@ -423,6 +427,7 @@ void FluentButtonWidget::focusOutEvent(QFocusEvent *event)
 
 void FluentButtonWidget::paintEvent(QPaintEvent *event)
 {
+    FLUENT_PERF_SCOPE(Paint);
     QPushButton::paintEvent(event);
 }
 
@@ -1,4 +1,5 @@
 #include "fluentcardwidget.h"
+#include "fluentperf.h"
 #include <QApplication>
 #include <QPalette>
 
@@ -97,6 +98,7 @@ void FluentCardWidget::setupShadowEffect()
 void FluentCardWidget::setupHoverAnimation()
 {
     m_hoverAnimation = new QPropertyAnimation(this, "pos", this);
+    FLUENT_PERF_ANIMATION(m_hoverAnimation);
     m_hoverAnimation->setDuration(200);
     m_hoverAnimation->setEasingCurve(QEasingCurve::OutCubic);
 
@@ -111,6 +113,7 @@ void FluentCardWidget::updateTheme()
 
 void FluentCardWidget::updateStyles()
 {
+    FLUENT_PERF_SCOPE(StyleUpdate);
     QString cardStyle;
     QString progressStyle;
 
@@ -252,6 +255,7 @@ void FluentCardWidget::onHoverAnimationFinished()
 
 void FluentCardWidget::paintEvent(QPaintEvent *event)
 {
+    FLUENT_PERF_SCOPE(Paint);
     QStyleOption opt;
     opt.initFrom(this);
     QPainter p(this);
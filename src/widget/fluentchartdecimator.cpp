@@ -0,0 +1,159 @@
+#include "fluentchartdecimator.h"
+
+#include <cmath>
+
+QList<QPointF> FluentChartDecimator::copyAll(const QPointF *points, qsizetype count, QList<qsizetype> *rawIndices)
+{
+    QList<QPointF> result;
+    result.reserve(count);
+    if (rawIndices) {
+        rawIndices->clear();
+        rawIndices->reserve(count);
+    }
+
+    for (qsizetype i = 0; i < count; ++i) {
+        result.append(points[i]);
+        if (rawIndices) rawIndices->append(i);
+    }
+
+    return result;
+}
+
+QList<QPointF> FluentChartDecimator::copyAll(const double *x, const double *y, qsizetype count,
+                                             QList<qsizetype> *rawIndices)
+{
+    QList<QPointF> result;
+    result.reserve(count);
+    if (rawIndices) {
+        rawIndices->clear();
+        rawIndices->reserve(count);
+    }
+
+    for (qsizetype i = 0; i < count; ++i) {
+        result.append(QPointF(x[i], y[i]));
+        if (rawIndices) rawIndices->append(i);
+    }
+
+    return result;
+}
+
+QList<QPointF> FluentChartDecimator::lttb(const QPointF *points, qsizetype count, qsizetype threshold,
+                                          QList<qsizetype> *rawIndices)
+{
+    if (!points || count <= 0) {
+        if (rawIndices) rawIndices->clear();
+        return QList<QPointF>();
+    }
+
+    // The algorithm needs the two fixed end points plus at least one bucket
+    threshold = qMax(threshold, qsizetype(3));
+    if (count <= threshold) {
+        return copyAll(points, count, rawIndices);
+    }
+
+    QList<QPointF> sampled;
+    sampled.reserve(threshold);
+    if (rawIndices) {
+        rawIndices->clear();
+        rawIndices->reserve(threshold);
+    }
+
+    auto take = [&](qsizetype index) {
+        sampled.append(points[index]);
+        if (rawIndices) rawIndices->append(index);
+    };
+
+    // Always keep the first and last point, split the rest into equal buckets
+    const double bucketSize = double(count - 2) / double(threshold - 2);
+    qsizetype anchor = 0;
+    take(0);
+
+    for (qsizetype bucket = 0; bucket < threshold - 2; ++bucket) {
+        const qsizetype start = qsizetype(bucket * bucketSize) + 1;
+        const qsizetype end = qsizetype((bucket + 1) * bucketSize) + 1;
+
+        // The third vertex of the triangle is the average of the next bucket
+        const qsizetype nextStart = end;
+        const qsizetype nextEnd = qMin(qsizetype((bucket + 2) * bucketSize) + 1, count);
+        double avgX = 0.0;
+        double avgY = 0.0;
+        for (qsizetype i = nextStart; i < nextEnd; ++i) {
+            avgX += points[i].x();
+            avgY += points[i].y();
+        }
+        const qsizetype nextCount = qMax(nextEnd - nextStart, qsizetype(1));
+        avgX /= nextCount;
+        avgY /= nextCount;
+
+        const double anchorX = points[anchor].x();
+        const double anchorY = points[anchor].y();
+
+        qsizetype chosen = start;
+        double maxArea = -1.0;
+        for (qsizetype i = start; i < end; ++i) {
+            const double area = std::abs((anchorX - avgX) * (points[i].y() - anchorY)
+                                         - (anchorX - points[i].x()) * (avgY - anchorY));
+            if (area > maxArea) {
+                maxArea = area;
+                chosen = i;
+            }
+        }
+
+        take(chosen);
+        anchor = chosen;
+    }
+
+    take(count - 1);
+    return sampled;
+}
+
+QList<QPointF> FluentChartDecimator::minMaxEnvelope(const double *x, const double *y, qsizetype count,
+                                                    qsizetype buckets, QList<qsizetype> *rawIndices)
+{
+    if (!x || !y || count <= 0) {
+        if (rawIndices) rawIndices->clear();
+        return QList<QPointF>();
+    }
+
+    buckets = qMax(buckets, qsizetype(1));
+    if (count <= 2 * buckets) {
+        return copyAll(x, y, count, rawIndices);
+    }
+
+    QList<QPointF> envelope;
+    envelope.reserve(2 * buckets);
+    if (rawIndices) {
+        rawIndices->clear();
+        rawIndices->reserve(2 * buckets);
+    }
+
+    auto take = [&](qsizetype index) {
+        envelope.append(QPointF(x[index], y[index]));
+        if (rawIndices) rawIndices->append(index);
+    };
+
+    const double bucketSize = double(count) / double(buckets);
+    for (qsizetype bucket = 0; bucket < buckets; ++bucket) {
+        const qsizetype start = qsizetype(bucket * bucketSize);
+        const qsizetype end = bucket == buckets - 1 ? count : qsizetype((bucket + 1) * bucketSize);
+
+        qsizetype minIndex = -1;
+        qsizetype maxIndex = -1;
+        for (qsizetype i = start; i < end; ++i) {
+            const double value = y[i];
+            if (!std::isfinite(value)) continue;
+            if (minIndex < 0 || value < y[minIndex]) minIndex = i;
+            if (maxIndex < 0 || value > y[maxIndex]) maxIndex = i;
+        }
+
+        if (minIndex < 0) continue;
+
+        // Emit in index order so the line is still drawn left to right
+        take(qMin(minIndex, maxIndex));
+        if (minIndex != maxIndex) {
+            take(qMax(minIndex, maxIndex));
+        }
+    }
+
+    return envelope;
+}
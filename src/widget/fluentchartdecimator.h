@@ -0,0 +1,29 @@
+#ifndef FLUENTCHARTDECIMATOR_H
+#define FLUENTCHARTDECIMATOR_H
+
+#include <QList>
+#include <QPointF>
+
+// Reduces a series to roughly one point per horizontal pixel before it is
+// handed to Qt Charts. Both algorithms expect points ordered by x and can
+// report, for every output point, the index of the raw point it came from.
+class FluentChartDecimator
+{
+public:
+    // Largest-Triangle-Three-Buckets: keeps the visually most significant
+    // point of each bucket. Produces at most threshold points.
+    static QList<QPointF> lttb(const QPointF *points, qsizetype count, qsizetype threshold,
+                               QList<qsizetype> *rawIndices = nullptr);
+
+    // Min/max envelope: keeps the lowest and highest point of each bucket so
+    // spikes survive. Produces at most 2 * buckets points. Works on x and y
+    // columns; only the y column is scanned.
+    static QList<QPointF> minMaxEnvelope(const double *x, const double *y, qsizetype count, qsizetype buckets,
+                                         QList<qsizetype> *rawIndices = nullptr);
+
+private:
+    static QList<QPointF> copyAll(const QPointF *points, qsizetype count, QList<qsizetype> *rawIndices);
+    static QList<QPointF> copyAll(const double *x, const double *y, qsizetype count, QList<qsizetype> *rawIndices);
+};
+
+#endif // FLUENTCHARTDECIMATOR_H
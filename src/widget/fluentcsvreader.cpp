@@ -0,0 +1,273 @@
+#include "fluentcsvreader.h"
+
+#include <QFileInfo>
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+// Large enough to keep the worker busy between progress and cancellation
+// checks, small enough that the carried partial line stays cheap to move
+const qint64 kChunkSize = 4 * 1024 * 1024;
+
+}
+
+FluentCsvReader::FluentCsvReader(const QString &fileName)
+    : m_file(fileName)
+    , m_fileSize(0)
+    , m_bytesRead(0)
+    , m_atEnd(false)
+    , m_delimiter(',')
+    , m_hasXColumn(true)
+    , m_headerRead(false)
+    , m_categoricalX(false)
+{
+}
+
+bool FluentCsvReader::isCsvFile(const QString &fileName)
+{
+    const QString suffix = QFileInfo(fileName).suffix().toLower();
+    return suffix == QLatin1String("csv") || suffix == QLatin1String("tsv") || suffix == QLatin1String("txt");
+}
+
+bool FluentCsvReader::open()
+{
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        m_errorString = m_file.errorString();
+        m_atEnd = true;
+        return false;
+    }
+
+    m_fileSize = m_file.size();
+    return true;
+}
+
+QString FluentCsvReader::errorString() const
+{
+    return m_errorString;
+}
+
+bool FluentCsvReader::readChunk()
+{
+    if (m_atEnd) return false;
+
+    const qsizetype carried = m_buffer.size();
+    m_buffer.resize(carried + kChunkSize);
+    const qint64 count = m_file.read(m_buffer.data() + carried, kChunkSize);
+    if (count < 0) {
+        m_errorString = m_file.errorString();
+        m_buffer.clear();
+        m_atEnd = true;
+        return false;
+    }
+
+    m_buffer.resize(carried + count);
+    m_bytesRead += count;
+    const bool last = count == 0 || m_file.atEnd();
+
+    // Parse every complete line; the tail waits for the next chunk
+    const char *line = m_buffer.constData();
+    const char *end = line + m_buffer.size();
+    while (const char *newline = static_cast<const char *>(std::memchr(line, '\n', end - line))) {
+        parseLine(line, newline);
+        line = newline + 1;
+    }
+
+    if (last) {
+        if (line < end) {
+            parseLine(line, end);
+        }
+        m_buffer.clear();
+        m_file.close();
+        m_atEnd = true;
+        return false;
+    }
+
+    // Size the columns for the whole file from the first chunk, so they
+    // don't reallocate (and briefly double) on the way
+    if (m_bytesRead == count && m_bytesRead > 0 && m_fileSize > m_bytesRead) {
+        reserveRows(qsizetype(double(m_columns.rows.size()) * m_fileSize / m_bytesRead * 1.02));
+    }
+
+    m_buffer.remove(0, line - m_buffer.constData());
+    return true;
+}
+
+bool FluentCsvReader::atEnd() const
+{
+    return m_atEnd;
+}
+
+int FluentCsvReader::progress() const
+{
+    return m_fileSize > 0 ? int(m_bytesRead * 100 / m_fileSize) : 100;
+}
+
+qsizetype FluentCsvReader::rowCount() const
+{
+    return m_columns.rows.size();
+}
+
+FluentCsvReader::Columns FluentCsvReader::takeColumns()
+{
+    Columns columns = std::move(m_columns);
+    m_columns = Columns();
+    return columns;
+}
+
+void FluentCsvReader::parseLine(const char *begin, const char *end)
+{
+    if (begin < end && end[-1] == '\r') {
+        --end;
+    }
+
+    const char *first = begin;
+    while (first < end && (*first == ' ' || *first == '\t')) {
+        ++first;
+    }
+    if (first == end) return;
+
+    if (!m_headerRead) {
+        // The delimiter is whichever candidate the first line uses most
+        const qsizetype commas = std::count(begin, end, ',');
+        const qsizetype semicolons = std::count(begin, end, ';');
+        const qsizetype tabs = std::count(begin, end, '\t');
+        m_delimiter = tabs > commas && tabs > semicolons ? '\t' : (semicolons > commas ? ';' : ',');
+
+        splitLine(begin, end);
+        m_headerRead = true;
+        if (parseHeader()) return;
+    } else {
+        splitLine(begin, end);
+    }
+
+    const qsizetype row = m_columns.rows.size();
+    const int seriesCount = int(m_columns.y.size());
+    const int firstSeriesField = m_hasXColumn ? 1 : 0;
+
+    double x = double(row);
+    if (m_hasXColumn) {
+        // The first data row decides whether x is numeric or a label
+        if (row == 0) {
+            m_categoricalX = !toValue(m_fields.first(), &x);
+        }
+
+        if (m_categoricalX) {
+            const Field &field = m_fields.first();
+            m_columns.categories.append(QString::fromUtf8(field.begin, int(field.end - field.begin)));
+            x = double(row);
+        } else if (!toValue(m_fields.first(), &x) || std::isnan(x)) {
+            // A row without a usable x has no place on the axis
+            return;
+        }
+    }
+    m_columns.rows.append(x);
+
+    for (int series = 0; series < seriesCount; ++series) {
+        const int field = series + firstSeriesField;
+        QList<double> &yValues = m_columns.y[series];
+
+        double value = 0.0;
+        if (field < m_fields.size() && toValue(m_fields.at(field), &value) && !std::isnan(value)) {
+            yValues.append(value);
+            if (m_hasGaps.at(series)) {
+                m_columns.x[series].append(x);
+            }
+        } else if (!m_hasGaps.at(series)) {
+            // First unusable cell: this series gets its own x column
+            m_hasGaps[series] = true;
+            m_columns.x[series] = m_columns.rows.mid(0, yValues.size());
+        }
+    }
+}
+
+bool FluentCsvReader::parseHeader()
+{
+    // Called with the fields of the first line; returns true if it names
+    // the series rather than holding data
+    m_hasXColumn = m_fields.size() > 1;
+    const int firstSeriesField = m_hasXColumn ? 1 : 0;
+    const int seriesCount = int(m_fields.size()) - firstSeriesField;
+
+    bool isHeader = false;
+    for (int field = firstSeriesField; field < m_fields.size() && !isHeader; ++field) {
+        double value = 0.0;
+        isHeader = !toValue(m_fields.at(field), &value) && m_fields.at(field).begin != m_fields.at(field).end;
+    }
+
+    for (int series = 0; series < seriesCount; ++series) {
+        const Field &field = m_fields.at(series + firstSeriesField);
+        QString name = isHeader ? QString::fromUtf8(field.begin, int(field.end - field.begin)) : QString();
+        if (name.isEmpty()) {
+            name = QStringLiteral("Series %1").arg(series + 1);
+        }
+        m_columns.seriesNames.append(name);
+    }
+
+    m_columns.x = QList<QList<double>>(seriesCount);
+    m_columns.y = QList<QList<double>>(seriesCount);
+    m_hasGaps = QList<bool>(seriesCount, false);
+    return isHeader;
+}
+
+void FluentCsvReader::splitLine(const char *begin, const char *end)
+{
+    m_fields.clear();
+
+    const char *field = begin;
+    while (true) {
+        const char *next = static_cast<const char *>(std::memchr(field, m_delimiter, end - field));
+        const char *fieldEnd = next ? next : end;
+
+        // Surrounding blanks and quotes are not part of the value
+        const char *first = field;
+        const char *last = fieldEnd;
+        while (first < last && (*first == ' ' || *first == '\t')) ++first;
+        while (last > first && (last[-1] == ' ' || last[-1] == '\t')) --last;
+        if (last - first >= 2 && *first == '"' && last[-1] == '"') {
+            ++first;
+            --last;
+        }
+        m_fields.append(Field{first, last});
+
+        if (!next) break;
+        field = next + 1;
+    }
+}
+
+void FluentCsvReader::reserveRows(qsizetype rows)
+{
+    m_columns.rows.reserve(rows);
+    for (int series = 0; series < m_columns.y.size(); ++series) {
+        m_columns.y[series].reserve(rows);
+        if (m_hasGaps.at(series)) {
+            m_columns.x[series].reserve(rows);
+        }
+    }
+    if (m_categoricalX) {
+        m_columns.categories.reserve(rows);
+    }
+}
+
+bool FluentCsvReader::toValue(const Field &field, double *value)
+{
+    const char *begin = field.begin;
+    if (begin < field.end && *begin == '+') {
+        ++begin;
+    }
+    if (begin == field.end) return false;
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    // Locale independent and allocation free
+    const std::from_chars_result result = std::from_chars(begin, field.end, *value);
+    return result.ec == std::errc() && result.ptr == field.end;
+#else
+    // Standard libraries without floating point from_chars
+    bool ok = false;
+    *value = QByteArray::fromRawData(begin, int(field.end - begin)).toDouble(&ok);
+    return ok;
+#endif
+}
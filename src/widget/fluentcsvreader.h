@@ -0,0 +1,83 @@
+#ifndef FLUENTCSVREADER_H
+#define FLUENTCSVREADER_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+// Series columns read from a delimited text file
+struct FluentCsvColumns {
+    QStringList seriesNames;
+    QStringList categories;
+    QList<double> rows;         // shared x column of series without gaps
+    QList<QList<double>> x;     // per series, empty when rows applies
+    QList<QList<double>> y;
+};
+
+// Reads a delimited text file into series columns, a fixed-size chunk at a
+// time, so it can run on a worker thread with progress and cancellation
+// checked between chunks. Values are parsed straight from the bytes; no
+// cell is ever stored as a string or QVariant.
+//
+// The first column holds x, every further column one series. A first line
+// with a non-numeric field after the first names the series. When the
+// first data row has no numeric x, x values become row numbers and the
+// first column is kept as category labels. Comma, semicolon and tab are
+// recognised as delimiters; fields may be quoted but not contain the
+// delimiter. Empty, unreadable and NaN cells are left out of their series.
+class FluentCsvReader
+{
+public:
+    using Columns = FluentCsvColumns;
+
+    explicit FluentCsvReader(const QString &fileName);
+
+    // True for the file suffixes the reader handles: csv, tsv and txt
+    static bool isCsvFile(const QString &fileName);
+
+    bool open();
+    QString errorString() const;
+
+    // Reads and parses the next chunk; returns false once the whole file has
+    // been read or on error
+    bool readChunk();
+    bool atEnd() const;
+
+    // Percentage of the file read so far
+    int progress() const;
+    qsizetype rowCount() const;
+
+    // The columns read so far; leaves the reader empty
+    Columns takeColumns();
+
+private:
+    struct Field {
+        const char *begin;
+        const char *end;
+    };
+
+    void parseLine(const char *begin, const char *end);
+    bool parseHeader();
+    void splitLine(const char *begin, const char *end);
+    void reserveRows(qsizetype rows);
+    static bool toValue(const Field &field, double *value);
+
+    QFile m_file;
+    QString m_errorString;
+    qint64 m_fileSize;
+    qint64 m_bytesRead;
+    bool m_atEnd;
+
+    QByteArray m_buffer;        // bytes of an unfinished line carried to the next chunk
+    QList<Field> m_fields;      // fields of the line being parsed, reused across lines
+    char m_delimiter;
+    bool m_hasXColumn;
+    bool m_headerRead;
+    bool m_categoricalX;
+    QList<bool> m_hasGaps;      // per series, true once it has its own x column
+    Columns m_columns;
+};
+
+#endif // FLUENTCSVREADER_H
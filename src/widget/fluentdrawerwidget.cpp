@@ -1,4 +1,5 @@
 #include "fluentdrawerwidget.h"
+#include "fluentperf.h"
 #include <QApplication>
 #include <QScreen>
 
@@ -185,6 +186,7 @@ void FluentDrawerWidget::setupAnimations()
 {
     // Slide animation
     m_slideAnimation = new QPropertyAnimation(this, "pos", this);
+    FLUENT_PERF_ANIMATION(m_slideAnimation);
     m_slideAnimation->setDuration(300);
     m_slideAnimation->setEasingCurve(QEasingCurve::OutCubic);
 
@@ -193,6 +195,7 @@ void FluentDrawerWidget::setupAnimations()
     setGraphicsEffect(m_opacityEffect);
 
     m_opacityAnimation = new QPropertyAnimation(m_opacityEffect, "opacity", this);
+    FLUENT_PERF_ANIMATION(m_opacityAnimation);
     m_opacityAnimation->setDuration(300);
 
     // Animation group
@@ -211,6 +214,7 @@ void FluentDrawerWidget::updateTheme()
 
 void FluentDrawerWidget::updateStyles()
 {
+    FLUENT_PERF_SCOPE(StyleUpdate);
     QString drawerStyle;
     QString buttonStyle;
     QString primaryButtonStyle;
@@ -626,6 +630,7 @@ void FluentDrawerWidget::onHideAnimationFinished()
 
 void FluentDrawerWidget::paintEvent(QPaintEvent *event)
 {
+    FLUENT_PERF_SCOPE(Paint);
     QStyleOption opt;
     opt.initFrom(this);
     QPainter p(this);
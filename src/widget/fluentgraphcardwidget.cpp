@@ -4,6 +4,7 @@
 #include <QRandomGenerator>
 
 // Qt Charts includes
+#ifndef FLUENTWIDGET_NO_QTCHARTS
 #include <QChart>
 #include <QChartView>
 #include <QLineSeries>
@@ -12,9 +13,74 @@
 #include <QPieSeries>
 #include <QScatterSeries>
 #include <QAreaSeries>
+#include <QXYSeries>
 #include <QValueAxis>
+#include <QDateTimeAxis>
 #include <QBarCategoryAxis>
 #include <QLegend>
+#include <QGraphicsScene>
+#endif
+
+#include <QHash>
+#include <QTimer>
+#include <QtConcurrent>
+#include <QWheelEvent>
+#include <QFileInfo>
+#include <QUrl>
+#include <QPromise>
+
+#include "fluentchartdecimator.h"
+#include "fluentcsvreader.h"
+#include "fluentmappedseriesfile.h"
+#include "fluentserieskernels.h"
+#include "fluentperf.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// Builds without Qt Charts only have the raster backend
+#ifdef FLUENTWIDGET_NO_QTCHARTS
+static const FluentGraphCardWidget::RenderBackend kDefaultRenderBackend = FluentGraphCardWidget::RasterBackend;
+#else
+static const FluentGraphCardWidget::RenderBackend kDefaultRenderBackend = FluentGraphCardWidget::QtChartsBackend;
+#endif
+
+// Quality is lowered after a few slow frames but only raised after a long
+// run of cheap ones, so it does not flip back and forth at the threshold
+static const int kSlowFramesToDegrade = 3;
+static const int kFastFramesToRecover = 60;
+
+// Largest time in milliseconds a double x column holds exactly (2^53)
+static const qint64 kMaxExactMsecs = Q_INT64_C(9007199254740992);
+
+#ifndef FLUENTWIDGET_NO_QTCHARTS
+// Dynamic property marking the line series that draw statistic overlays
+static const char kOverlayProperty[] = "fluentOverlay";
+#endif
+
+namespace {
+
+void readCsvFile(QPromise<FluentCsvColumns> &promise, const QString &fileName)
+{
+    // Runs on a worker thread: a failed or cancelled read reports no result
+    FluentCsvReader reader(fileName);
+    if (!reader.open()) return;
+
+    promise.setProgressRange(0, 100);
+    while (reader.readChunk()) {
+        promise.suspendIfRequested();
+        if (promise.isCanceled()) return;
+        promise.setProgressValue(reader.progress());
+    }
+
+    if (!reader.errorString().isEmpty() || promise.isCanceled()) return;
+
+    promise.setProgressValue(100);
+    promise.addResult(reader.takeColumns());
+}
+
+} // namespace
 
 FluentGraphCardWidget::FluentGraphCardWidget(QWidget *parent)
     : QWidget(parent)
@@ -34,21 +100,104 @@ FluentGraphCardWidget::FluentGraphCardWidget(QWidget *parent)
     , m_accentColor(QColor(0, 120, 215))
     , m_dataSource("Sample Data")
     , m_animated(true)
+    , m_decimationMode(LTTBDecimation)
+    , m_renderBackend(kDefaultRenderBackend)
+    , m_localSeriesStore(nullptr)
+    , m_seriesData(nullptr)
+    , m_categories(nullptr)
+    , m_decimationBuckets(0)
+    , m_viewportZoomed(false)
+    , m_viewMinX(0.0)
+    , m_viewMaxX(0.0)
+    , m_panning(false)
+    , m_panStartMinX(0.0)
+    , m_panStartMaxX(0.0)
+    , m_hitTestIndexValid(false)
     , m_dataModel(nullptr)
     , m_xColumn(0)
     , m_seriesNamesColumn(-1)
+    , m_modelRowCount(-1)
+    , m_modelRowsInOrder(true)
+    , m_asyncModelLoading(false)
+    , m_modelLoadGeneration(0)
+    , m_modelLoadWatcher(nullptr)
+    , m_modelFlushTimer(nullptr)
+    , m_maxModelUpdateRate(0)
+    , m_modelReloadPending(false)
+    , m_modelAppendPending(false)
+    , m_dirtyFirstRow(-1)
+    , m_dirtyLastRow(-1)
+    , m_dirtyFirstColumn(-1)
+    , m_dirtyLastColumn(-1)
+    , m_dataSourceWatcher(nullptr)
+    , m_csvLoadWatcher(nullptr)
     , m_isHovered(false)
     , m_hoverOffset(0.0)
     , m_hoveredPointIndex(-1)
     , m_chartInitialized(false)
+    , m_refreshTimer(nullptr)
+    , m_maxRefreshRate(60)
+    , m_dirtyFlags(0)
+    , m_adaptiveQuality(true)
+    , m_frameBudget(16)
+    , m_renderQuality(FullQuality)
+    , m_frameCost(0.0)
+    , m_pendingUpdateNsecs(0)
+    , m_slowFrames(0)
+    , m_fastFrames(0)
+    , m_plotCacheValid(false)
+    , m_paintingPlot(false)
+    , m_overlays(NoOverlay)
+    , m_overlayWindow(20)
+    , m_ewmaAlpha(0.1)
+    , m_sigmaBandWidth(2.0)
+    , m_overlaySourceId(-1)
+    , m_timeSeries(false)
+    , m_timeFormat("hh:mm:ss")
+    , m_reorderWindow(100)
+    , m_reorderTimer(nullptr)
+    , m_lateSampleCount(0)
+    , m_maxSlices(0)
 {
     setupUI();
-    setupChart();
-    m_chartInitialized = true;
     setupShadowEffect();
     setupHoverAnimation();
 
-    // Load sample data first, then apply theme
+    // Chart refreshes are coalesced the same way
+    m_refreshTimer = new QTimer(this);
+    m_refreshTimer->setSingleShot(true);
+    connect(m_refreshTimer, &QTimer::timeout, this, &FluentGraphCardWidget::flushRefresh);
+
+    // Samples still held back go in once the stream pauses for a reorder window
+    m_reorderTimer = new QTimer(this);
+    m_reorderTimer->setSingleShot(true);
+    connect(m_reorderTimer, &QTimer::timeout, this, &FluentGraphCardWidget::flushSamples);
+
+    // Model changes are collected and applied together
+    m_modelFlushTimer = new QTimer(this);
+    m_modelFlushTimer->setSingleShot(true);
+    connect(m_modelFlushTimer, &QTimer::timeout, this, &FluentGraphCardWidget::flushModelChanges);
+
+    m_modelLoadWatcher = new QFutureWatcher<ModelColumns>(this);
+    connect(m_modelLoadWatcher, &QFutureWatcher<ModelColumns>::finished,
+            this, &FluentGraphCardWidget::onModelLoadFinished);
+
+    m_dataSourceWatcher = new QFileSystemWatcher(this);
+    connect(m_dataSourceWatcher, &QFileSystemWatcher::fileChanged,
+            this, &FluentGraphCardWidget::onDataSourceFileChanged);
+
+    m_csvLoadWatcher = new QFutureWatcher<FluentCsvColumns>(this);
+    connect(m_csvLoadWatcher, &QFutureWatcher<FluentCsvColumns>::progressValueChanged,
+            this, &FluentGraphCardWidget::loadProgress);
+    connect(m_csvLoadWatcher, &QFutureWatcher<FluentCsvColumns>::finished,
+            this, &FluentGraphCardWidget::onCsvLoadFinished);
+
+    // The card keeps its data in a store of its own until it is given a shared one
+    m_localSeriesStore = new FluentSeriesStore(this);
+    setSeriesStore(m_localSeriesStore);
+
+    // Load sample data first, then apply theme; the chart itself is only
+    // built once the card is first shown
     loadSampleData();
     updateTheme();
 
@@ -93,20 +242,53 @@ void FluentGraphCardWidget::setupUI()
 
 void FluentGraphCardWidget::setupChart()
 {
-    // Create chart
-    QChart *chart = new QChart();
-    chart->setAnimationOptions(m_animated ? QChart::AllAnimations : QChart::NoAnimation);
+    if (m_renderBackend == RasterBackend) {
+        // Plain widget painted with QPainter, no graphics scene behind it
+        FluentGraphRasterView *rasterView = new FluentGraphRasterView();
+        rasterView->setMinimumHeight(200);
+        m_chartView = rasterView;
+    }
+#ifndef FLUENTWIDGET_NO_QTCHARTS
+    else {
+        // Create chart
+        QChart *chart = new QChart();
+        chart->setAnimationOptions(animationsEnabled() ? QChart::AllAnimations : QChart::NoAnimation);
+
+        // Create chart view
+        QChartView *chartView = new QChartView(chart);
+        chartView->setRenderHint(QPainter::Antialiasing, m_renderQuality < AliasedQuality);
+        chartView->setMinimumHeight(200);
+        m_chartView = chartView; // Store as QWidget*
+
+        // Axis labels and the legend can move the plot area without a resize
+        connect(chart, &QChart::plotAreaChanged, this, &FluentGraphCardWidget::invalidateHitTestIndex);
+
+        // Any change to the scene, including Qt Charts animation steps and
+        // in-place series updates, makes the cached plot stale
+        connect(chartView->scene(), &QGraphicsScene::changed, this, &FluentGraphCardWidget::invalidatePlotCache);
+    }
+#endif
+    invalidatePlotCache();
 
-    // Create chart view
-    QChartView *chartView = new QChartView(chart);
-    chartView->setRenderHint(QPainter::Antialiasing);
-    chartView->setMinimumHeight(200);
-    m_chartView = chartView; // Store as QWidget*
+    // Wheel zoom, drag pan and plot resizes are handled on the plot widget
+    plotWidget()->installEventFilter(this);
 
     // Add chart view to main layout
     m_mainLayout->addWidget(m_chartView, 1);
 }
 
+void FluentGraphCardWidget::ensureChart()
+{
+    if (m_chartInitialized) return;
+
+    // Until now setters only recorded their state; the chart is built from
+    // it once, with the theme applied
+    setupChart();
+    m_chartInitialized = true;
+    m_dirtyFlags = 0;
+    applyChartTheme();
+}
+
 void FluentGraphCardWidget::setupShadowEffect()
 {
     m_shadowEffect = new QGraphicsDropShadowEffect(this);
@@ -120,6 +302,7 @@ void FluentGraphCardWidget::setupShadowEffect()
 void FluentGraphCardWidget::setupHoverAnimation()
 {
     m_hoverAnimation = new QPropertyAnimation(this, "pos", this);
+    FLUENT_PERF_ANIMATION(m_hoverAnimation);
     m_hoverAnimation->setDuration(200);
     m_hoverAnimation->setEasingCurve(QEasingCurve::OutCubic);
 
@@ -135,6 +318,7 @@ void FluentGraphCardWidget::updateTheme()
 
 void FluentGraphCardWidget::updateStyles()
 {
+    FLUENT_PERF_SCOPE(StyleUpdate);
     QString cardStyle;
 
     if (m_darkMode) {
@@ -169,46 +353,351 @@ void FluentGraphCardWidget::updateStyles()
 
 void FluentGraphCardWidget::applyChartTheme()
 {
+    applyChartStyle();
+
+    // The raster backend takes theme and legend from the scene it is given
+    updateChart();
+}
+
+void FluentGraphCardWidget::applyChartStyle()
+{
+    invalidatePlotCache();
+
+#ifndef FLUENTWIDGET_NO_QTCHARTS
     QChartView *chartView = qobject_cast<QChartView*>(m_chartView);
-    if (!chartView) return;
+    QChart *chart = chartView ? chartView->chart() : nullptr;
+
+    if (chart) {
+        // setTheme() restyles every series and axis, so it only runs when
+        // the theme changes or the view has not been styled yet
+        const QChart::ChartTheme theme = m_darkMode ? QChart::ChartThemeDark : QChart::ChartThemeLight;
+        if (chart->theme() != theme || chartView->styleSheet().isEmpty()) {
+            chart->setTheme(theme);
+            if (m_darkMode) {
+                chart->setBackgroundBrush(QBrush(QColor(45, 45, 45)));
+                chartView->setStyleSheet("QChartView { background-color: #2d2d2d; border: none; }");
+            } else {
+                chart->setBackgroundBrush(QBrush(QColor(255, 255, 255)));
+                chartView->setStyleSheet("QChartView { background-color: #ffffff; border: none; }");
+            }
+        }
 
-    QChart *chart = chartView->chart();
-    if (!chart) return;
+        // Configure legend
+        if (chart->legend()) {
+            chart->legend()->setVisible(m_showLegend);
+            chart->legend()->setAlignment(Qt::AlignBottom);
+        }
+    }
+#endif
+}
 
-    if (m_darkMode) {
-        chart->setTheme(QChart::ChartThemeDark);
-        chart->setBackgroundBrush(QBrush(QColor(45, 45, 45)));
-        chartView->setStyleSheet("QChartView { background-color: #2d2d2d; border: none; }");
+void FluentGraphCardWidget::scheduleRefresh(int flags)
+{
+    m_dirtyFlags |= flags;
+
+    // Before the first show the chart is built from scratch anyway
+    if (!m_chartInitialized || m_refreshTimer->isActive()) return;
+
+    // Without a rate limit the chart is refreshed on the next event loop turn
+    int delay = 0;
+    if (m_maxRefreshRate > 0 && m_refreshClock.isValid()) {
+        const qint64 interval = 1000 / m_maxRefreshRate;
+        delay = int(qMax(qint64(0), interval - m_refreshClock.elapsed()));
+    }
+    m_refreshTimer->start(delay);
+}
+
+void FluentGraphCardWidget::flushRefresh()
+{
+    const int flags = m_dirtyFlags;
+    m_dirtyFlags = 0;
+    m_refreshClock.start();
+
+    // Counted towards the next painted frame
+    QElapsedTimer timer;
+    timer.start();
+
+    // The raster backend paints everything from one fresh scene; Qt Charts
+    // area series and overlays take their colours when they are built
+    const bool rebuild = (flags & DirtyData)
+                         || qobject_cast<FluentGraphRasterView*>(m_chartView)
+                         || ((flags & DirtyStyle) && (m_graphType == AreaChart || showsOverlays()));
+
+    if (flags & DirtyStyle) {
+        applyChartStyle();
+    }
+
+    if (rebuild) {
+        updateChart();
+    } else if (flags & DirtyAxes) {
+#ifndef FLUENTWIDGET_NO_QTCHARTS
+        updateAxes();
+#endif
+    }
+
+    m_pendingUpdateNsecs += timer.nsecsElapsed();
+}
+
+bool FluentGraphCardWidget::animationsEnabled() const
+{
+    return m_animated && m_renderQuality < StaticQuality;
+}
+
+void FluentGraphCardWidget::recordFrameTime(qint64 nsecs)
+{
+    // Smoothed over the last few frames so a single slow one changes nothing
+    const double msecs = double(nsecs) / 1000000.0;
+    m_frameCost = m_frameCost > 0.0 ? 0.75 * m_frameCost + 0.25 * msecs : msecs;
+
+    if (!m_adaptiveQuality || m_frameBudget <= 0) return;
+
+    if (m_frameCost > m_frameBudget) {
+        ++m_slowFrames;
+        m_fastFrames = 0;
+    } else if (m_frameCost < 0.5 * m_frameBudget) {
+        ++m_fastFrames;
+        m_slowFrames = 0;
     } else {
-        chart->setTheme(QChart::ChartThemeLight);
-        chart->setBackgroundBrush(QBrush(QColor(255, 255, 255)));
-        chartView->setStyleSheet("QChartView { background-color: #ffffff; border: none; }");
+        m_slowFrames = 0;
+        m_fastFrames = 0;
     }
 
-    // Configure legend
-    if (chart->legend()) {
-        chart->legend()->setVisible(m_showLegend);
-        chart->legend()->setAlignment(Qt::AlignBottom);
+    if (m_slowFrames >= kSlowFramesToDegrade && m_renderQuality < CoarseQuality) {
+        setRenderQuality(RenderQuality(m_renderQuality + 1));
+    } else if (m_fastFrames >= kFastFramesToRecover && m_renderQuality > FullQuality) {
+        setRenderQuality(RenderQuality(m_renderQuality - 1));
     }
+}
 
-    updateChart();
+void FluentGraphCardWidget::setRenderQuality(RenderQuality quality)
+{
+    if (m_renderQuality == quality) return;
+
+    m_renderQuality = quality;
+    m_slowFrames = 0;
+    m_fastFrames = 0;
+    invalidatePlotCache();
+
+#ifndef FLUENTWIDGET_NO_QTCHARTS
+    if (QChartView *chartView = qobject_cast<QChartView*>(m_chartView)) {
+        chartView->setRenderHint(QPainter::Antialiasing, m_renderQuality < AliasedQuality);
+        if (QChart *chart = chartView->chart()) {
+            chart->setAnimationOptions(animationsEnabled() ? QChart::AllAnimations : QChart::NoAnimation);
+        }
+    }
+#endif
+
+    // Raster scenes carry their antialiasing; the bucket width changes with
+    // the coarse level
+    if (qobject_cast<FluentGraphRasterView*>(m_chartView)) {
+        scheduleRefresh(DirtyStyle);
+    }
+    if (m_decimationMode != NoDecimation && m_chartInitialized) {
+        updateDecimation();
+    }
+
+    emit renderQualityChanged(m_renderQuality);
+}
+
+bool FluentGraphCardWidget::renderPlotCache(QWidget *plot)
+{
+    // Returns true if the plot had to be rendered rather than reused
+    const qreal ratio = plot->devicePixelRatioF();
+    const QSize pixelSize = plot->size() * ratio;
+    if (m_plotCacheValid && m_plotCache.size() == pixelSize && qFuzzyCompare(m_plotCache.devicePixelRatio(), ratio)) {
+        return false;
+    }
+
+    // Only renders are counted; blits of the cache are part of the card paint
+    FLUENT_PERF_SCOPE(PlotRender);
+    if (m_plotCache.size() != pixelSize) {
+        m_plotCache = QPixmap(pixelSize);
+    }
+    m_plotCache.setDevicePixelRatio(ratio);
+    m_plotCache.fill(Qt::transparent);
+
+    // The nested paint event passes the event filter and paints as usual
+    m_paintingPlot = true;
+    plot->render(&m_plotCache, QPoint(), QRegion(), QWidget::DrawWindowBackground);
+    m_paintingPlot = false;
+
+    m_plotCacheValid = true;
+    return true;
+}
+
+void FluentGraphCardWidget::invalidatePlotCache()
+{
+    m_plotCacheValid = false;
+}
+
+// Statistic overlays
+bool FluentGraphCardWidget::showsOverlays() const
+{
+    return m_overlaySourceId >= 0
+           && (m_graphType == LineChart || m_graphType == ScatterChart || m_graphType == AreaChart);
+}
+
+void FluentGraphCardWidget::updateOverlay()
+{
+    int id = -1;
+    if (m_overlays != NoOverlay) {
+        id = m_overlaySeries.isEmpty() ? (m_seriesData->isEmpty() ? -1 : 0)
+                                       : m_seriesData->seriesId(m_overlaySeries);
+    }
+
+    if (id < 0) {
+        if (m_overlaySourceId >= 0 || m_overlay.size() > 0) {
+            m_overlay.reset(m_overlayWindow, m_ewmaAlpha, m_sigmaBandWidth);
+        }
+        m_overlaySourceId = -1;
+        return;
+    }
+    if (id == m_overlaySourceId) return;
+
+    // One pass over the window now; appends keep it current from here on
+    const FluentSpan<double> x = m_seriesData->xValues(id);
+    const FluentSpan<double> y = m_seriesData->yValues(id);
+    m_overlay.reset(m_overlayWindow, m_ewmaAlpha, m_sigmaBandWidth);
+    m_overlay.append(x.data(), y.data(), y.size());
+    m_overlaySourceId = id;
+}
+
+QList<FluentSeriesOverlay::Statistic> FluentGraphCardWidget::overlayStatistics() const
+{
+    QList<FluentSeriesOverlay::Statistic> statistics;
+    if (m_overlays & MovingAverageOverlay) {
+        statistics << FluentSeriesOverlay::MovingAverage;
+    }
+    if (m_overlays & EwmaOverlay) {
+        statistics << FluentSeriesOverlay::Ewma;
+    }
+    if (m_overlays & MinMaxBandOverlay) {
+        statistics << FluentSeriesOverlay::WindowMin << FluentSeriesOverlay::WindowMax;
+    }
+    if (m_overlays & SigmaBandOverlay) {
+        statistics << FluentSeriesOverlay::LowerBand << FluentSeriesOverlay::UpperBand;
+    }
+    return statistics;
+}
+
+QString FluentGraphCardWidget::overlayName(FluentSeriesOverlay::Statistic statistic) const
+{
+    const QString series = m_seriesData->seriesName(m_overlaySourceId);
+    switch (statistic) {
+        case FluentSeriesOverlay::MovingAverage:
+            return QStringLiteral("%1 MA(%2)").arg(series).arg(m_overlayWindow);
+        case FluentSeriesOverlay::Ewma:
+            return QStringLiteral("%1 EWMA(%2)").arg(series).arg(m_ewmaAlpha);
+        case FluentSeriesOverlay::WindowMin:
+            return QStringLiteral("%1 Min(%2)").arg(series).arg(m_overlayWindow);
+        case FluentSeriesOverlay::WindowMax:
+            return QStringLiteral("%1 Max(%2)").arg(series).arg(m_overlayWindow);
+        case FluentSeriesOverlay::LowerBand:
+            return QStringLiteral("%1 -%2\u03c3").arg(series).arg(m_sigmaBandWidth);
+        case FluentSeriesOverlay::UpperBand:
+            return QStringLiteral("%1 +%2\u03c3").arg(series).arg(m_sigmaBandWidth);
+        case FluentSeriesOverlay::StatisticCount:
+            break;
+    }
+    return series;
+}
+
+QColor FluentGraphCardWidget::overlayColor(FluentSeriesOverlay::Statistic statistic) const
+{
+    // Averages in a darker, bands in a lighter shade of the series colour
+    const QColor color = FluentGraphRenderer::seriesColor(m_overlaySourceId, m_accentColor);
+    return statistic == FluentSeriesOverlay::MovingAverage || statistic == FluentSeriesOverlay::Ewma
+               ? color.darker(150) : color.lighter(140);
+}
+
+QList<QPointF> FluentGraphCardWidget::overlayPoints(FluentSeriesOverlay::Statistic statistic) const
+{
+    const FluentSpan<double> x = m_overlay.xValues();
+    const FluentSpan<double> values = m_overlay.values(statistic);
+
+    // The visible x-range only, reduced like the series it follows
+    qsizetype first = 0;
+    qsizetype last = x.size();
+    if (m_viewportZoomed) {
+        first = std::lower_bound(x.begin(), x.end(), m_viewMinX) - x.begin();
+        last = std::upper_bound(x.begin() + first, x.end(), m_viewMaxX) - x.begin();
+    }
+
+    const qsizetype count = last - first;
+    if (needsDecimation(count)) {
+        return FluentChartDecimator::minMaxEnvelope(x.data() + first, values.data() + first, count,
+                                                    qMax(m_decimationBuckets, 1));
+    }
+
+    QList<QPointF> points;
+    points.reserve(count);
+    for (qsizetype i = first; i < last; ++i) {
+        points.append(QPointF(x[i], values[i]));
+    }
+    return points;
+}
+
+// Time series
+bool FluentGraphCardWidget::usesTimeAxis() const
+{
+    return m_timeSeries
+           && (m_graphType == LineChart || m_graphType == ScatterChart || m_graphType == AreaChart);
+}
+
+QString FluentGraphCardWidget::timeLabel(double x) const
+{
+    return QDateTime::fromMSecsSinceEpoch(qint64(x)).toString(m_timeFormat);
+}
+
+void FluentGraphCardWidget::commitSamples(const QString &series, const QList<FluentReorderBuffer::Sample> &samples)
+{
+    if (samples.isEmpty()) return;
+
+    QList<QPointF> points;
+    points.reserve(samples.size());
+    for (const FluentReorderBuffer::Sample &sample : samples) {
+        points.append(QPointF(double(sample.time), sample.value));
+    }
+    appendPoints(series, points);
 }
 
 void FluentGraphCardWidget::updateChart()
 {
+    FLUENT_PERF_SCOPE(ChartUpdate);
+    if (!m_chartView) return;
+
+    // Ensure we have data before creating charts; loading sample data
+    // refreshes the chart on its own. A shared store is left to whoever
+    // feeds it, an empty one shows an empty chart
+    if (m_seriesData->isEmpty() && m_seriesStore == m_localSeriesStore) {
+        loadSampleData();
+        return;
+    }
+
+    invalidatePlotCache();
+    updateOverlay();
+
+    // Decimation is recomputed against the current plot width
+    m_decimationBuckets = decimationBucketCount();
+    m_rawIndices.clear();
+    invalidateHitTestIndex();
+
+    // The raster backend only needs a fresh scene to paint
+    if (FluentGraphRasterView *rasterView = qobject_cast<FluentGraphRasterView*>(m_chartView)) {
+        rasterView->setScene(buildRasterScene());
+        return;
+    }
+
+#ifndef FLUENTWIDGET_NO_QTCHARTS
     QChartView *chartView = qobject_cast<QChartView*>(m_chartView);
     if (!chartView) return;
 
     QChart *chart = chartView->chart();
     if (!chart) return;
 
-    // Safely remove existing series
-    safelyRemoveAllSeries();
-
-    // Ensure we have data before creating charts
-    if (m_seriesData.isEmpty()) {
-        loadSampleData();
-    }
+    // Only series of a different kind are dropped, everything else is
+    // reconciled in place by the create* methods below
+    removeIncompatibleSeries();
 
     // Create appropriate chart type with error handling
     try {
@@ -233,111 +722,253 @@ void FluentGraphCardWidget::updateChart()
         // Fallback to line chart if creation fails
         if (m_graphType != LineChart) {
             m_graphType = LineChart;
+            removeIncompatibleSeries();
             createLineChart();
         }
     }
 
+    // Overlays go on top, or away for chart types that have none
+    updateOverlaySeries();
+
     // Update chart properties
-    chart->setAnimationOptions(m_animated ? QChart::AllAnimations : QChart::NoAnimation);
+    chart->setAnimationOptions(animationsEnabled() ? QChart::AllAnimations : QChart::NoAnimation);
+#endif
 }
 
-void FluentGraphCardWidget::createLineChart()
+FluentGraphScene FluentGraphCardWidget::buildRasterScene()
 {
-    QChartView *chartView = qobject_cast<QChartView*>(m_chartView);
-    if (!chartView) return;
-
-    QChart *chart = chartView->chart();
-    if (!chart) return;
+    FluentGraphScene scene;
+
+    // GraphType and FluentGraphScene::Kind share their order
+    scene.kind = static_cast<FluentGraphScene::Kind>(m_graphType);
+    scene.showGrid = m_showGrid;
+    scene.showLegend = m_showLegend;
+    scene.darkMode = m_darkMode;
+    scene.antialiased = m_renderQuality < AliasedQuality;
+    if (usesTimeAxis()) {
+        scene.timeFormat = m_timeFormat;
+    }
 
-    for (auto it = m_seriesData.constBegin(); it != m_seriesData.constEnd(); ++it) {
-        QLineSeries *series = new QLineSeries();
-        series->setName(it.key());
+    for (int id = 0; id < m_seriesData->seriesCount(); ++id) {
+        FluentGraphScene::Series series;
+        series.name = m_seriesData->seriesName(id);
+        series.color = FluentGraphRenderer::seriesColor(id, m_accentColor);
 
-        for (const QPointF &point : it.value()) {
-            series->append(point);
+        if (m_graphType == BarChart || m_graphType == PieChart) {
+            const FluentSpan<double> values = m_seriesData->yValues(id);
+            series.values = QList<qreal>(values.begin(), values.end());
+        } else {
+            series.points = decimatedPoints(id);
         }
 
-        chart->addSeries(series);
-    }
+        scene.series.append(series);
 
-    chart->createDefaultAxes();
+        // Area and pie charts only show the first series
+        if (m_graphType == AreaChart || m_graphType == PieChart) {
+            break;
+        }
+    }
 
-    // Configure axes
-    if (!chart->axes(Qt::Horizontal).isEmpty()) {
-        QValueAxis *axisX = qobject_cast<QValueAxis*>(chart->axes(Qt::Horizontal).first());
-        if (axisX) {
-            axisX->setGridLineVisible(m_showGrid);
+    setSceneCategories(&scene, *m_categories);
+    if (m_graphType == PieChart && !scene.series.isEmpty()) {
+        updatePieSlices();
+        scene.categories = m_pieSlices.labels;
+        scene.series.first().values = m_pieSlices.values;
+    }
+    axisRanges(&scene.minX, &scene.maxX, &scene.minY, &scene.maxY);
+
+    if (showsOverlays()) {
+        for (FluentSeriesOverlay::Statistic statistic : overlayStatistics()) {
+            FluentGraphScene::Series overlay;
+            overlay.name = overlayName(statistic);
+            overlay.color = overlayColor(statistic);
+            overlay.points = overlayPoints(statistic);
+            scene.overlays.append(overlay);
         }
     }
+    return scene;
+}
 
-    if (!chart->axes(Qt::Vertical).isEmpty()) {
-        QValueAxis *axisY = qobject_cast<QValueAxis*>(chart->axes(Qt::Vertical).first());
-        if (axisY) {
-            axisY->setGridLineVisible(m_showGrid);
+void FluentGraphCardWidget::setSceneCategories(FluentGraphScene *scene, const QStringList &categories)
+{
+    if (scene->kind == FluentGraphScene::Pie && !scene->series.isEmpty()) {
+        // One slice per category, as in the Qt Charts backend
+        QList<qreal> &values = scene->series.first().values;
+        const qsizetype sliceCount = qMin(values.size(), qsizetype(categories.size()));
+        values.resize(sliceCount);
+        scene->categories = categories.mid(0, sliceCount);
+    } else if (scene->kind == FluentGraphScene::Bar) {
+        // Number the bars when no categories were provided
+        scene->categories = categories;
+        if (scene->categories.isEmpty()) {
+            qsizetype categoryCount = 0;
+            for (const FluentGraphScene::Series &series : std::as_const(scene->series)) {
+                categoryCount = qMax(categoryCount, series.values.size());
+            }
+            for (qsizetype i = 0; i < categoryCount; ++i) {
+                scene->categories << QString::number(i + 1);
+            }
         }
     }
 }
 
-void FluentGraphCardWidget::createBarChart()
+QImage FluentGraphCardWidget::renderImage(const RenderConfig &config, const FluentSeriesTable &series,
+                                          const QStringList &categories, const QSize &size,
+                                          qreal devicePixelRatio)
 {
-    QChartView *chartView = qobject_cast<QChartView*>(m_chartView);
-    if (!chartView) return;
+    // Only the arguments are read; the table's columns are implicitly
+    // shared, so a copy handed to each worker costs nothing
+    FluentGraphScene scene;
+    scene.kind = static_cast<FluentGraphScene::Kind>(config.graphType);
+    scene.showGrid = config.showGrid;
+    scene.showLegend = config.showLegend;
+    scene.darkMode = config.darkMode;
+
+    const bool categorical = config.graphType == BarChart || config.graphType == PieChart;
+    const bool singleSeries = config.graphType == AreaChart || config.graphType == PieChart;
+    if (config.timeSeries && !categorical) {
+        scene.timeFormat = config.timeFormat;
+    }
 
-    QChart *chart = chartView->chart();
-    if (!chart) return;
+    double lowX = std::numeric_limits<double>::max();
+    double highX = std::numeric_limits<double>::lowest();
+    double lowY = std::numeric_limits<double>::max();
+    double highY = std::numeric_limits<double>::lowest();
 
-    QBarSeries *barSeries = new QBarSeries();
+    for (int id = 0; id < series.seriesCount(); ++id) {
+        FluentGraphScene::Series sceneSeries;
+        sceneSeries.name = series.seriesName(id);
+        sceneSeries.color = FluentGraphRenderer::seriesColor(id, config.accentColor);
 
-    for (auto it = m_seriesData.constBegin(); it != m_seriesData.constEnd(); ++it) {
-        QBarSet *barSet = new QBarSet(it.key());
+        const FluentSpan<double> x = series.xValues(id);
+        const FluentSpan<double> y = series.yValues(id);
+        if (categorical) {
+            sceneSeries.values = QList<qreal>(y.begin(), y.end());
+        }
 
-        for (const QPointF &point : it.value()) {
-            barSet->append(point.y());
+        const FluentSeriesKernels::Extents extents = FluentSeriesKernels::extents(x.data(), y.data(), y.size());
+        if (extents.isValid()) {
+            lowX = qMin(lowX, extents.minX);
+            highX = qMax(highX, extents.maxX);
+            lowY = qMin(lowY, extents.minY);
+            highY = qMax(highY, extents.maxY);
         }
 
-        barSeries->append(barSet);
+        scene.series.append(sceneSeries);
+        if (singleSeries) break;
     }
 
-    chart->addSeries(barSeries);
-    chart->createDefaultAxes();
+    setSceneCategories(&scene, categories);
+    if (config.graphType == PieChart && config.maxSlices > 0 && !scene.series.isEmpty()) {
+        FluentTopNSelector selector;
+        const PieSlices slices = pieSlices(&selector, series.yValues(0), categories,
+                                           QList<qsizetype>(), config.maxSlices);
+        scene.categories = slices.labels;
+        scene.series.first().values = slices.values;
+    }
+
+    // Same axis rules as axisRanges(), without a viewport
+    if (lowX <= highX && lowY <= highY) {
+        if (config.graphType == AreaChart || config.graphType == BarChart) {
+            lowY = qMin(lowY, 0.0);
+            highY = qMax(highY, 0.0);
+        }
+        if (qFuzzyCompare(lowX, highX)) {
+            lowX -= 1.0;
+            highX += 1.0;
+        }
+        if (qFuzzyCompare(lowY, highY)) {
+            lowY -= 1.0;
+            highY += 1.0;
+        }
+        scene.minX = lowX;
+        scene.maxX = highX;
+        scene.minY = lowY;
+        scene.maxY = highY;
+    }
 
-    // Set categories for bar chart
-    if (!m_categories.isEmpty() && !chart->axes(Qt::Horizontal).isEmpty()) {
-        QBarCategoryAxis *axisX = new QBarCategoryAxis();
-        axisX->append(m_categories);
-        chart->setAxisX(axisX, barSeries);
+    if (!categorical) {
+        // One bucket per device pixel of the plot, as on screen
+        const QRectF plot = FluentGraphRenderer::plotArea(QRectF(QPointF(0, 0), QSizeF(size)), scene);
+        const qsizetype buckets = qMax(qsizetype(plot.width() * devicePixelRatio), qsizetype(3));
+
+        for (int i = 0; i < scene.series.size(); ++i) {
+            const FluentSpan<double> x = series.xValues(i);
+            const FluentSpan<double> y = series.yValues(i);
+            QList<QPointF> &points = scene.series[i].points;
+
+            switch (config.decimationMode) {
+                case LTTBDecimation:
+                case MinMaxEnvelopeDecimation:
+                    // LTTB picks from the envelope, as decimatedPoints() does
+                    points = FluentChartDecimator::minMaxEnvelope(x.data(), y.data(), y.size(), buckets);
+                    if (config.decimationMode == LTTBDecimation) {
+                        points = lttbFromEnvelope(points, buckets);
+                    }
+                    break;
+                case NoDecimation:
+                    points = series.points(i);
+                    break;
+            }
+        }
     }
+
+    return FluentGraphRenderer::render(scene, size, devicePixelRatio);
 }
 
-void FluentGraphCardWidget::createPieChart()
+bool FluentGraphCardWidget::axisRanges(double *minX, double *maxX, double *minY, double *maxY)
 {
-    QChartView *chartView = qobject_cast<QChartView*>(m_chartView);
-    if (!chartView) return;
+    double lowX = std::numeric_limits<double>::max();
+    double highX = std::numeric_limits<double>::lowest();
+    double lowY = std::numeric_limits<double>::max();
+    double highY = std::numeric_limits<double>::lowest();
 
-    QChart *chart = chartView->chart();
-    if (!chart || m_seriesData.isEmpty()) return;
+    // Bars sit on categories and are never zoomed
+    const bool zoomed = m_viewportZoomed && m_graphType != BarChart;
 
-    QPieSeries *pieSeries = new QPieSeries();
+    for (int id = 0; id < m_seriesData->seriesCount(); ++id) {
+        seriesExtents(id, zoomed, &lowX, &highX, &lowY, &highY);
 
-    // Use first series data for pie chart
-    auto firstSeries = m_seriesData.constBegin();
-    for (int i = 0; i < firstSeries.value().size() && i < m_categories.size(); ++i) {
-        QString label = m_categories[i];
-        double value = firstSeries.value()[i].y();
-        pieSeries->append(label, value);
+        // Area charts only show the first series
+        if (m_graphType == AreaChart) {
+            break;
+        }
     }
 
-    // Highlight first slice
-    if (pieSeries->count() > 0) {
-        QPieSlice *firstSlice = pieSeries->slices().at(0);
-        firstSlice->setExploded(true);
-        firstSlice->setLabelVisible(true);
+    if (lowY > highY) return false;
+
+    if (zoomed) {
+        lowX = m_viewMinX;
+        highX = m_viewMaxX;
+    }
+
+    if (lowX > highX) return false;
+
+    // Areas are filled down to zero and bars grow from it
+    if (m_graphType == AreaChart || m_graphType == BarChart) {
+        lowY = qMin(lowY, 0.0);
+        highY = qMax(highY, 0.0);
+    }
+
+    if (qFuzzyCompare(lowX, highX)) {
+        lowX -= 1.0;
+        highX += 1.0;
+    }
+    if (qFuzzyCompare(lowY, highY)) {
+        lowY -= 1.0;
+        highY += 1.0;
     }
 
-    chart->addSeries(pieSeries);
+    *minX = lowX;
+    *maxX = highX;
+    *minY = lowY;
+    *maxY = highY;
+    return true;
 }
 
-void FluentGraphCardWidget::createScatterChart()
+#ifndef FLUENTWIDGET_NO_QTCHARTS
+
+void FluentGraphCardWidget::removeIncompatibleSeries()
 {
     QChartView *chartView = qobject_cast<QChartView*>(m_chartView);
     if (!chartView) return;
@@ -345,22 +976,86 @@ void FluentGraphCardWidget::createScatterChart()
     QChart *chart = chartView->chart();
     if (!chart) return;
 
-    for (auto it = m_seriesData.constBegin(); it != m_seriesData.constEnd(); ++it) {
-        QScatterSeries *series = new QScatterSeries();
-        series->setName(it.key());
-        series->setMarkerSize(8.0);
+    QAbstractSeries::SeriesType wanted = QAbstractSeries::SeriesTypeLine;
+    switch (m_graphType) {
+        case LineChart:    wanted = QAbstractSeries::SeriesTypeLine;    break;
+        case BarChart:     wanted = QAbstractSeries::SeriesTypeBar;     break;
+        case PieChart:     wanted = QAbstractSeries::SeriesTypePie;     break;
+        case ScatterChart: wanted = QAbstractSeries::SeriesTypeScatter; break;
+        case AreaChart:    wanted = QAbstractSeries::SeriesTypeArea;    break;
+    }
+
+    // Overlay series are kept or dropped by updateOverlaySeries()
+    const QList<QAbstractSeries*> seriesList = chart->series();
+    for (QAbstractSeries *series : seriesList) {
+        if (series && series->type() != wanted && !isOverlaySeries(series)) {
+            chart->removeSeries(series);
+            series->deleteLater();
+        }
+    }
+
+    // Pie charts have no axes
+    if (m_graphType == PieChart) {
+        const QList<QAbstractAxis*> axes = chart->axes();
+        for (QAbstractAxis *axis : axes) {
+            chart->removeAxis(axis);
+            axis->deleteLater();
+        }
+    }
+}
+
+QAbstractAxis *FluentGraphCardWidget::ensureAxis(Qt::Orientation orientation, bool category)
+{
+    QChartView *chartView = qobject_cast<QChartView*>(m_chartView);
+    if (!chartView) return nullptr;
 
-        for (const QPointF &point : it.value()) {
-            series->append(point);
+    QChart *chart = chartView->chart();
+    if (!chart) return nullptr;
+
+    // Time series plot x on a date/time axis
+    const bool time = !category && orientation == Qt::Horizontal && usesTimeAxis();
+
+    // Keep the first axis of the right kind, drop anything else on that side
+    QAbstractAxis *kept = nullptr;
+    const QList<QAbstractAxis*> axes = chart->axes(orientation);
+    for (QAbstractAxis *axis : axes) {
+        const bool matches = category ? qobject_cast<QBarCategoryAxis*>(axis) != nullptr
+                             : time   ? qobject_cast<QDateTimeAxis*>(axis) != nullptr
+                                      : qobject_cast<QValueAxis*>(axis) != nullptr;
+        if (matches && !kept) {
+            kept = axis;
+        } else {
+            chart->removeAxis(axis);
+            axis->deleteLater();
         }
+    }
 
-        chart->addSeries(series);
+    if (!kept) {
+        if (category) {
+            kept = new QBarCategoryAxis();
+        } else if (time) {
+            kept = new QDateTimeAxis();
+        } else {
+            kept = new QValueAxis();
+        }
+        chart->addAxis(kept, orientation == Qt::Horizontal ? Qt::AlignBottom : Qt::AlignLeft);
     }
 
-    chart->createDefaultAxes();
+    return kept;
 }
 
-void FluentGraphCardWidget::createAreaChart()
+void FluentGraphCardWidget::attachAxes(QAbstractSeries *series, QAbstractAxis *axisX, QAbstractAxis *axisY)
+{
+    const QList<QAbstractAxis*> attached = series->attachedAxes();
+    if (axisX && !attached.contains(axisX)) {
+        series->attachAxis(axisX);
+    }
+    if (axisY && !attached.contains(axisY)) {
+        series->attachAxis(axisY);
+    }
+}
+
+void FluentGraphCardWidget::removeSeries(const QList<QAbstractSeries*> &seriesList)
 {
     QChartView *chartView = qobject_cast<QChartView*>(m_chartView);
     if (!chartView) return;
@@ -368,449 +1063,2489 @@ void FluentGraphCardWidget::createAreaChart()
     QChart *chart = chartView->chart();
     if (!chart) return;
 
-    // Validate data availability
-    if (m_seriesData.isEmpty()) {
-        loadSampleData();
-        if (m_seriesData.isEmpty()) {
-            return; // Still no data, abort
+    for (QAbstractSeries *series : seriesList) {
+        if (series) {
+            chart->removeSeries(series);
+            series->deleteLater();
         }
     }
+}
 
-    // Get the first series with valid data
-    auto firstSeries = m_seriesData.constBegin();
-    if (firstSeries == m_seriesData.constEnd() || firstSeries.value().isEmpty()) {
-        return; // No valid data
-    }
+void FluentGraphCardWidget::updateOverlaySeries()
+{
+    QChartView *chartView = qobject_cast<QChartView*>(m_chartView);
+    if (!chartView) return;
 
-    // Create the upper boundary line series
-    QLineSeries *upperSeries = new QLineSeries();
-    upperSeries->setName(firstSeries.key());
+    QChart *chart = chartView->chart();
+    if (!chart) return;
 
-    // Add points with validation
-    for (const QPointF &point : firstSeries.value()) {
-        // Validate point data
-        if (std::isfinite(point.x()) && std::isfinite(point.y())) {
-            upperSeries->append(point);
+    QHash<QString, QAbstractSeries*> existing;
+    for (QAbstractSeries *series : chart->series()) {
+        if (isOverlaySeries(series)) {
+            existing.insert(series->name(), series);
         }
     }
 
-    // Only create area series if we have valid points
-    if (upperSeries->count() == 0) {
-        delete upperSeries;
-        return;
-    }
+    if (showsOverlays()) {
+        QAbstractAxis *axisX = ensureAxis(Qt::Horizontal, false);
+        QAbstractAxis *axisY = ensureAxis(Qt::Vertical, false);
+
+        for (FluentSeriesOverlay::Statistic statistic : overlayStatistics()) {
+            const QString name = overlayName(statistic);
+            QLineSeries *series = qobject_cast<QLineSeries*>(existing.take(name));
+            const QList<QPointF> points = overlayPoints(statistic);
+
+            if (!series) {
+                series = new QLineSeries();
+                series->setName(name);
+                series->setProperty(kOverlayProperty, true);
+                series->replace(points);
+                chart->addSeries(series);
+            } else if (series->points() != points) {
+                series->replace(points);
+            }
 
-    // Create lower boundary (baseline at 0) if we want a filled area from zero
-    QLineSeries *lowerSeries = new QLineSeries();
-    for (const QPointF &point : firstSeries.value()) {
-        if (std::isfinite(point.x())) {
-            lowerSeries->append(QPointF(point.x(), 0));
+            // Themes restyle every series, so the pen is set on each rebuild
+            QPen pen(overlayColor(statistic), 1.5, Qt::DashLine);
+            series->setPen(pen);
+            attachAxes(series, axisX, axisY);
         }
     }
 
-    // Create area series with both upper and lower boundaries
-    QAreaSeries *areaSeries = nullptr;
-    if (lowerSeries->count() > 0) {
-        areaSeries = new QAreaSeries(upperSeries, lowerSeries);
-    } else {
-        delete lowerSeries;
-        areaSeries = new QAreaSeries(upperSeries);
-    }
+    removeSeries(existing.values());
+}
 
-    if (!areaSeries) {
-        delete upperSeries;
-        return;
-    }
+bool FluentGraphCardWidget::appendToOverlaySeries(qsizetype appended, qsizetype removed)
+{
+    // Only called once appendToChartSeries() patched the series the overlay
+    // follows, so the overlays are on screen undecimated as well
+    QChartView *chartView = qobject_cast<QChartView*>(m_chartView);
+    QChart *chart = chartView ? chartView->chart() : nullptr;
+    if (!chart) return false;
+
+    const FluentSpan<double> x = m_overlay.xValues();
+    const qsizetype size = x.size();
+    const qsizetype tail = qMin(appended, size);
+
+    for (FluentSeriesOverlay::Statistic statistic : overlayStatistics()) {
+        const QString name = overlayName(statistic);
+        QXYSeries *series = nullptr;
+        for (QAbstractSeries *abstractSeries : chart->series()) {
+            if (isOverlaySeries(abstractSeries) && abstractSeries->name() == name) {
+                series = qobject_cast<QXYSeries*>(abstractSeries);
+                break;
+            }
+        }
+        if (!series) return false;
 
-    areaSeries->setName(firstSeries.key());
+        if (removed >= series->count() || series->count() - removed + tail != size) {
+            series->replace(overlayPoints(statistic));
+            continue;
+        }
 
-    // Set area color with transparency
-    QColor areaColor = m_accentColor;
-    areaColor.setAlpha(100); // Make it semi-transparent
-    areaSeries->setBrush(QBrush(areaColor));
+        if (removed > 0) {
+            series->removePoints(0, int(removed));
+        }
 
-    // Set border color
-    QPen pen(m_accentColor);
-    pen.setWidth(2);
-    areaSeries->setPen(pen);
+        const FluentSpan<double> values = m_overlay.values(statistic);
+        QList<QPointF> points;
+        points.reserve(tail);
+        for (qsizetype i = size - tail; i < size; ++i) {
+            points.append(QPointF(x[i], values[i]));
+        }
+        series->append(points);
+    }
+    return true;
+}
+
+bool FluentGraphCardWidget::isOverlaySeries(const QAbstractSeries *series)
+{
+    return series && series->property(kOverlayProperty).toBool();
+}
 
-    // Add series to chart
-    chart->addSeries(areaSeries);
+void FluentGraphCardWidget::updateAxes()
+{
+    QChartView *chartView = qobject_cast<QChartView*>(m_chartView);
+    if (!chartView) return;
 
-    // Create axes after adding series
-    chart->createDefaultAxes();
+    QChart *chart = chartView->chart();
+    if (!chart) return;
+
+    const QList<QAbstractAxis*> horizontalAxes = chart->axes(Qt::Horizontal);
+    const QList<QAbstractAxis*> verticalAxes = chart->axes(Qt::Vertical);
+    if (horizontalAxes.isEmpty() || verticalAxes.isEmpty()) return;
+
+    for (QAbstractAxis *axis : horizontalAxes + verticalAxes) {
+        axis->setGridLineVisible(m_showGrid);
+    }
+
+    // Ranges are set explicitly so the axes can stay alive across updates
+    QValueAxis *axisX = qobject_cast<QValueAxis*>(horizontalAxes.first());
+    QDateTimeAxis *timeAxis = qobject_cast<QDateTimeAxis*>(horizontalAxes.first());
+    QValueAxis *axisY = qobject_cast<QValueAxis*>(verticalAxes.first());
+    if (!axisY) return;
+
+    double minX = 0.0;
+    double maxX = 0.0;
+    double minY = 0.0;
+    double maxY = 0.0;
+    if (!axisRanges(&minX, &maxX, &minY, &maxY)) return;
+
+    if (axisX) {
+        axisX->setRange(minX, maxX);
+    }
+    if (timeAxis) {
+        timeAxis->setFormat(m_timeFormat);
+        timeAxis->setRange(QDateTime::fromMSecsSinceEpoch(qint64(std::floor(minX))),
+                           QDateTime::fromMSecsSinceEpoch(qint64(std::ceil(maxX))));
+    }
+    axisY->setRange(minY, maxY);
+}
+
+void FluentGraphCardWidget::createLineChart()
+{
+    QChartView *chartView = qobject_cast<QChartView*>(m_chartView);
+    if (!chartView) return;
+
+    QChart *chart = chartView->chart();
+    if (!chart) return;
+
+    QAbstractAxis *axisX = ensureAxis(Qt::Horizontal, false);
+    QValueAxis *axisY = qobject_cast<QValueAxis*>(ensureAxis(Qt::Vertical, false));
+
+    QHash<QString, QAbstractSeries*> existing;
+    for (QAbstractSeries *series : chart->series()) {
+        if (!isOverlaySeries(series)) {
+            existing.insert(series->name(), series);
+        }
+    }
+
+    for (int id = 0; id < m_seriesData->seriesCount(); ++id) {
+        const QString name = m_seriesData->seriesName(id);
+        QLineSeries *series = qobject_cast<QLineSeries*>(existing.take(name));
+        const QList<QPointF> points = decimatedPoints(id);
+
+        if (!series) {
+            series = new QLineSeries();
+            series->setName(name);
+            series->replace(points);
+            chart->addSeries(series);
+        } else if (series->points() != points) {
+            series->replace(points);
+        }
+
+        attachAxes(series, axisX, axisY);
+    }
+
+    removeSeries(existing.values());
+    updateAxes();
+}
+
+void FluentGraphCardWidget::createBarChart()
+{
+    QChartView *chartView = qobject_cast<QChartView*>(m_chartView);
+    if (!chartView) return;
+
+    QChart *chart = chartView->chart();
+    if (!chart) return;
+
+    QBarSeries *barSeries = nullptr;
+    QList<QAbstractSeries*> extraSeries;
+    for (QAbstractSeries *series : chart->series()) {
+        if (!barSeries) {
+            barSeries = qobject_cast<QBarSeries*>(series);
+            if (barSeries) continue;
+        }
+        extraSeries.append(series);
+    }
+    removeSeries(extraSeries);
+
+    if (!barSeries) {
+        barSeries = new QBarSeries();
+        chart->addSeries(barSeries);
+    }
+
+    QHash<QString, QBarSet*> existingSets;
+    for (QBarSet *barSet : barSeries->barSets()) {
+        existingSets.insert(barSet->label(), barSet);
+    }
+
+    int categoryCount = 0;
+    for (int id = 0; id < m_seriesData->seriesCount(); ++id) {
+        const QString name = m_seriesData->seriesName(id);
+        QBarSet *barSet = existingSets.take(name);
+        const bool isNewSet = !barSet;
+        if (isNewSet) {
+            barSet = new QBarSet(name);
+        }
+
+        const FluentSpan<double> values = m_seriesData->yValues(id);
+        if (barSet->count() == values.size()) {
+            // Same shape: only touch bars whose value actually changed
+            for (int i = 0; i < values.size(); ++i) {
+                if (barSet->at(i) != values[i]) {
+                    barSet->replace(i, values[i]);
+                }
+            }
+        } else {
+            barSet->remove(0, barSet->count());
+            barSet->append(QList<qreal>(values.begin(), values.end()));
+        }
+
+        if (isNewSet) {
+            barSeries->append(barSet);
+        }
+
+        categoryCount = qMax(categoryCount, int(values.size()));
+    }
+
+    for (QBarSet *staleSet : std::as_const(existingSets)) {
+        barSeries->remove(staleSet);
+    }
+
+    // Set categories for bar chart, numbering bars when none were provided
+    QStringList categories = *m_categories;
+    if (categories.isEmpty()) {
+        for (int i = 0; i < categoryCount; ++i) {
+            categories << QString::number(i + 1);
+        }
+    }
+
+    QBarCategoryAxis *axisX = qobject_cast<QBarCategoryAxis*>(ensureAxis(Qt::Horizontal, true));
+    QValueAxis *axisY = qobject_cast<QValueAxis*>(ensureAxis(Qt::Vertical, false));
+    if (axisX && axisX->categories() != categories) {
+        axisX->setCategories(categories);
+    }
+    attachAxes(barSeries, axisX, axisY);
+    updateAxes();
+}
+
+void FluentGraphCardWidget::createPieChart()
+{
+    QChartView *chartView = qobject_cast<QChartView*>(m_chartView);
+    if (!chartView) return;
+
+    QChart *chart = chartView->chart();
+    if (!chart || m_seriesData->isEmpty()) return;
+
+    QPieSeries *pieSeries = nullptr;
+    QList<QAbstractSeries*> extraSeries;
+    for (QAbstractSeries *series : chart->series()) {
+        if (!pieSeries) {
+            pieSeries = qobject_cast<QPieSeries*>(series);
+            if (pieSeries) continue;
+        }
+        extraSeries.append(series);
+    }
+    removeSeries(extraSeries);
+
+    const bool isNewSeries = !pieSeries;
+    if (isNewSeries) {
+        pieSeries = new QPieSeries();
+        connect(pieSeries, &QPieSeries::clicked, this, &FluentGraphCardWidget::onPieSliceClicked);
+    }
+
+    // Use first series data for pie chart
+    updatePieSlices();
+    const int sliceCount = int(m_pieSlices.values.size());
+
+    if (pieSeries->count() == sliceCount) {
+        const QList<QPieSlice*> slices = pieSeries->slices();
+        for (int i = 0; i < sliceCount; ++i) {
+            const double value = m_pieSlices.values.at(i);
+            if (slices[i]->label() != m_pieSlices.labels.at(i)) {
+                slices[i]->setLabel(m_pieSlices.labels.at(i));
+            }
+            if (slices[i]->value() != value) {
+                slices[i]->setValue(value);
+            }
+        }
+    } else {
+        pieSeries->clear();
+        for (int i = 0; i < sliceCount; ++i) {
+            pieSeries->append(m_pieSlices.labels.at(i), m_pieSlices.values.at(i));
+        }
+    }
+
+    // Highlight first slice
+    if (pieSeries->count() > 0) {
+        QPieSlice *firstSlice = pieSeries->slices().at(0);
+        firstSlice->setExploded(true);
+        firstSlice->setLabelVisible(true);
+    }
+
+    if (isNewSeries) {
+        chart->addSeries(pieSeries);
+    }
+}
+
+void FluentGraphCardWidget::createScatterChart()
+{
+    QChartView *chartView = qobject_cast<QChartView*>(m_chartView);
+    if (!chartView) return;
+
+    QChart *chart = chartView->chart();
+    if (!chart) return;
+
+    QAbstractAxis *axisX = ensureAxis(Qt::Horizontal, false);
+    QValueAxis *axisY = qobject_cast<QValueAxis*>(ensureAxis(Qt::Vertical, false));
+
+    QHash<QString, QAbstractSeries*> existing;
+    for (QAbstractSeries *series : chart->series()) {
+        if (!isOverlaySeries(series)) {
+            existing.insert(series->name(), series);
+        }
+    }
+
+    for (int id = 0; id < m_seriesData->seriesCount(); ++id) {
+        const QString name = m_seriesData->seriesName(id);
+        QScatterSeries *series = qobject_cast<QScatterSeries*>(existing.take(name));
+        const QList<QPointF> points = decimatedPoints(id);
+
+        if (!series) {
+            series = new QScatterSeries();
+            series->setName(name);
+            series->setMarkerSize(8.0);
+            series->replace(points);
+            chart->addSeries(series);
+        } else if (series->points() != points) {
+            series->replace(points);
+        }
+
+        attachAxes(series, axisX, axisY);
+    }
+
+    removeSeries(existing.values());
+    updateAxes();
+}
+
+void FluentGraphCardWidget::createAreaChart()
+{
+    QChartView *chartView = qobject_cast<QChartView*>(m_chartView);
+    if (!chartView) return;
+
+    QChart *chart = chartView->chart();
+    if (!chart) return;
+
+    // Validate data availability
+    if (m_seriesData->isEmpty()) {
+        return;
+    }
+
+    QAreaSeries *areaSeries = nullptr;
+    QList<QAbstractSeries*> extraSeries;
+    for (QAbstractSeries *series : chart->series()) {
+        if (isOverlaySeries(series)) continue;
+        if (!areaSeries) {
+            areaSeries = qobject_cast<QAreaSeries*>(series);
+            if (areaSeries) continue;
+        }
+        extraSeries.append(series);
+    }
+    removeSeries(extraSeries);
+
+    // Get the first series with valid data
+    const QString name = m_seriesData->seriesName(0);
+    const QList<QPointF> points = decimatedPoints(0);
+
+    // Collect the upper boundary and the zero baseline in one pass,
+    // skipping invalid points
+    QList<QPointF> upperPoints(points.size());
+    QList<QPointF> lowerPoints(points.size());
+    qsizetype upperCount = 0;
+    qsizetype lowerCount = 0;
+    FluentSeriesKernels::areaBoundaries(points.constData(), points.size(), 0.0,
+                                        upperPoints.data(), &upperCount, lowerPoints.data(), &lowerCount);
+    upperPoints.resize(upperCount);
+    lowerPoints.resize(lowerCount);
+
+    // Only keep an area series if we have valid points
+    if (upperPoints.isEmpty()) {
+        if (areaSeries) {
+            removeSeries({areaSeries});
+        }
+        return;
+    }
+
+    if (!areaSeries) {
+        QLineSeries *upperSeries = new QLineSeries();
+        upperSeries->replace(upperPoints);
+
+        QLineSeries *lowerSeries = new QLineSeries();
+        lowerSeries->replace(lowerPoints);
+
+        areaSeries = new QAreaSeries(upperSeries, lowerSeries);
+        areaSeries->setName(name);
+        chart->addSeries(areaSeries);
+    } else {
+        if (areaSeries->name() != name) {
+            areaSeries->setName(name);
+        }
+        if (areaSeries->upperSeries()->points() != upperPoints) {
+            areaSeries->upperSeries()->replace(upperPoints);
+        }
+        if (!areaSeries->lowerSeries()) {
+            areaSeries->setLowerSeries(new QLineSeries());
+        }
+        if (areaSeries->lowerSeries()->points() != lowerPoints) {
+            areaSeries->lowerSeries()->replace(lowerPoints);
+        }
+    }
+
+    // Set area color with transparency
+    QColor areaColor = m_accentColor;
+    areaColor.setAlpha(100); // Make it semi-transparent
+    areaSeries->setBrush(QBrush(areaColor));
+
+    // Set border color
+    QPen pen(m_accentColor);
+    pen.setWidth(2);
+    areaSeries->setPen(pen);
+
+    QAbstractAxis *axisX = ensureAxis(Qt::Horizontal, false);
+    QValueAxis *axisY = qobject_cast<QValueAxis*>(ensureAxis(Qt::Vertical, false));
+    attachAxes(areaSeries, axisX, axisY);
+    updateAxes();
+}
+
+#endif // FLUENTWIDGET_NO_QTCHARTS
+
+void FluentGraphCardWidget::loadSampleData()
+{
+    // A shared store is left to whoever feeds it; other cards show it too
+    if (m_seriesStore != m_localSeriesStore) return;
+
+    clearData();
+
+    // Add sample categories
+    *m_categories << "Jan" << "Feb" << "Mar" << "Apr" << "May" << "Jun";
+
+    // Generate sample data based on chart type
+    switch (m_graphType) {
+        case LineChart:
+        case ScatterChart:
+        case AreaChart: {
+            QList<QPointF> series1, series2;
+            for (int i = 0; i < 6; ++i) {
+                series1.append(QPointF(i, QRandomGenerator::global()->bounded(20, 80)));
+                series2.append(QPointF(i, QRandomGenerator::global()->bounded(10, 60)));
+            }
+            m_seriesData->setPoints(m_seriesData->addSeries("Revenue"), series1);
+            m_seriesData->setPoints(m_seriesData->addSeries("Expenses"), series2);
+            break;
+        }
+        case BarChart: {
+            QList<QPointF> series1, series2;
+            for (int i = 0; i < 6; ++i) {
+                series1.append(QPointF(i, QRandomGenerator::global()->bounded(10, 50)));
+                series2.append(QPointF(i, QRandomGenerator::global()->bounded(5, 30)));
+            }
+            m_seriesData->setPoints(m_seriesData->addSeries("Sales"), series1);
+            m_seriesData->setPoints(m_seriesData->addSeries("Target"), series2);
+            break;
+        }
+        case PieChart: {
+            QList<QPointF> series1;
+            series1.append(QPointF(0, 30));
+            series1.append(QPointF(1, 25));
+            series1.append(QPointF(2, 20));
+            series1.append(QPointF(3, 15));
+            series1.append(QPointF(4, 10));
+            m_seriesData->setPoints(m_seriesData->addSeries("Distribution"), series1);
+            m_categories->clear();
+            *m_categories << "Category A" << "Category B" << "Category C" << "Category D" << "Category E";
+            break;
+        }
+    }
+
+    m_seriesStore->notifyDataReset();
+}
+
+// Property implementations
+QString FluentGraphCardWidget::title() const { return m_title; }
+void FluentGraphCardWidget::setTitle(const QString &title)
+{
+    m_title = title;
+    if (m_titleLabel) m_titleLabel->setText(title);
+}
+
+QString FluentGraphCardWidget::subtitle() const { return m_subtitle; }
+void FluentGraphCardWidget::setSubtitle(const QString &subtitle)
+{
+    m_subtitle = subtitle;
+    if (m_subtitleLabel) m_subtitleLabel->setText(subtitle);
+}
+
+FluentGraphCardWidget::GraphType FluentGraphCardWidget::graphType() const { return m_graphType; }
+void FluentGraphCardWidget::setGraphType(GraphType type)
+{
+    if (m_graphType == type) return;
+
+    m_graphType = type;
+    m_viewportZoomed = false;
+
+    // Ensure we have appropriate data for the new chart type; the chart
+    // itself is left alone until it has been built
+    if (m_seriesStore == m_localSeriesStore
+        && (m_seriesData->isEmpty() || (type == PieChart && m_categories->isEmpty()))) {
+        loadSampleData();
+    }
+    scheduleRefresh(DirtyData);
+}
+
+bool FluentGraphCardWidget::showLegend() const { return m_showLegend; }
+void FluentGraphCardWidget::setShowLegend(bool show)
+{
+    m_showLegend = show;
+    scheduleRefresh(DirtyStyle);
+}
+
+bool FluentGraphCardWidget::showGrid() const { return m_showGrid; }
+void FluentGraphCardWidget::setShowGrid(bool show)
+{
+    m_showGrid = show;
+    scheduleRefresh(DirtyAxes);
+}
+
+bool FluentGraphCardWidget::isDarkMode() const { return m_darkMode; }
+void FluentGraphCardWidget::setDarkMode(bool dark)
+{
+    m_darkMode = dark;
+    updateStyles();
+    scheduleRefresh(DirtyStyle);
+}
+
+QColor FluentGraphCardWidget::accentColor() const { return m_accentColor; }
+void FluentGraphCardWidget::setAccentColor(const QColor &color)
+{
+    m_accentColor = color;
+    scheduleRefresh(DirtyStyle);
+}
+
+QString FluentGraphCardWidget::dataSource() const { return m_dataSource; }
+void FluentGraphCardWidget::setDataSource(const QString &source)
+{
+    m_dataSource = source;
+
+    // A local file is read directly; anything else only labels the data
+    const QString fileName = dataSourceFileName(source);
+    if (!fileName.isEmpty() && loadDataFromFile(fileName)) {
+        return;
+    }
+
+    // If we have a data model, try to load from it
+    if (m_dataModel) {
+        loadDataFromModel();
+    } else {
+        // Fallback to sample data
+        loadSampleData();
+    }
+}
+
+bool FluentGraphCardWidget::isAnimated() const { return m_animated; }
+void FluentGraphCardWidget::setAnimated(bool animated)
+{
+    m_animated = animated;
+#ifndef FLUENTWIDGET_NO_QTCHARTS
+    QChartView *chartView = qobject_cast<QChartView*>(m_chartView);
+    if (chartView) {
+        QChart *chart = chartView->chart();
+        if (chart) {
+            chart->setAnimationOptions(animationsEnabled() ? QChart::AllAnimations : QChart::NoAnimation);
+        }
+    }
+#endif
+}
+
+FluentGraphCardWidget::RenderBackend FluentGraphCardWidget::renderBackend() const { return m_renderBackend; }
+void FluentGraphCardWidget::setRenderBackend(RenderBackend backend)
+{
+#ifdef FLUENTWIDGET_NO_QTCHARTS
+    // Built without Qt Charts: the raster backend is the only one available
+    backend = RasterBackend;
+#endif
+    if (m_renderBackend == backend) return;
+
+    m_renderBackend = backend;
+    if (!m_chartInitialized || !m_chartView) return;
+
+    // Swap the chart area widget; the new one is filled from the stored data
+    m_mainLayout->removeWidget(m_chartView);
+    m_chartView->hide();
+    m_chartView->deleteLater();
+    m_chartView = nullptr;
+    m_rawIndices.clear();
+
+    setupChart();
+    applyChartTheme();
+}
+
+int FluentGraphCardWidget::maxRefreshRate() const { return m_maxRefreshRate; }
+void FluentGraphCardWidget::setMaxRefreshRate(int rate)
+{
+    m_maxRefreshRate = qMax(0, rate);
+}
+
+bool FluentGraphCardWidget::isAdaptiveQuality() const { return m_adaptiveQuality; }
+void FluentGraphCardWidget::setAdaptiveQuality(bool adaptive)
+{
+    m_adaptiveQuality = adaptive;
+    if (!m_adaptiveQuality) {
+        setRenderQuality(FullQuality);
+    }
+}
+
+int FluentGraphCardWidget::frameBudget() const { return m_frameBudget; }
+void FluentGraphCardWidget::setFrameBudget(int msecs)
+{
+    m_frameBudget = qMax(0, msecs);
+    m_slowFrames = 0;
+    m_fastFrames = 0;
+}
+
+FluentGraphCardWidget::RenderQuality FluentGraphCardWidget::renderQuality() const { return m_renderQuality; }
+
+FluentGraphCardWidget::Overlays FluentGraphCardWidget::overlays() const { return m_overlays; }
+void FluentGraphCardWidget::setOverlays(Overlays overlays)
+{
+    if (m_overlays == overlays) return;
+
+    // Every statistic is computed together, so switching between them keeps
+    // the running state; turning all of them off releases it
+    m_overlays = overlays;
+    if (m_overlays == NoOverlay) {
+        m_overlaySourceId = -1;
+    }
+    scheduleRefresh(DirtyData);
+}
+
+QString FluentGraphCardWidget::overlaySeries() const { return m_overlaySeries; }
+void FluentGraphCardWidget::setOverlaySeries(const QString &series)
+{
+    m_overlaySeries = series;
+    m_overlaySourceId = -1;
+    scheduleRefresh(DirtyData);
+}
+
+int FluentGraphCardWidget::overlayWindow() const { return m_overlayWindow; }
+void FluentGraphCardWidget::setOverlayWindow(int points)
+{
+    m_overlayWindow = qMax(1, points);
+    m_overlaySourceId = -1;
+    scheduleRefresh(DirtyData);
+}
+
+double FluentGraphCardWidget::ewmaAlpha() const { return m_ewmaAlpha; }
+void FluentGraphCardWidget::setEwmaAlpha(double alpha)
+{
+    m_ewmaAlpha = qBound(0.0, alpha, 1.0);
+    m_overlaySourceId = -1;
+    scheduleRefresh(DirtyData);
+}
+
+double FluentGraphCardWidget::sigmaBandWidth() const { return m_sigmaBandWidth; }
+void FluentGraphCardWidget::setSigmaBandWidth(double deviations)
+{
+    m_sigmaBandWidth = qMax(0.0, deviations);
+    m_overlaySourceId = -1;
+    scheduleRefresh(DirtyData);
+}
+
+bool FluentGraphCardWidget::isTimeSeries() const { return m_timeSeries; }
+void FluentGraphCardWidget::setTimeSeries(bool timeSeries)
+{
+    if (m_timeSeries == timeSeries) return;
+
+    // The model X column changes meaning; any other data only changes axis
+    m_timeSeries = timeSeries;
+    if (m_dataModel) {
+        scheduleModelReload();
+    } else {
+        scheduleRefresh(DirtyData);
+    }
+}
+
+QString FluentGraphCardWidget::timeFormat() const { return m_timeFormat; }
+void FluentGraphCardWidget::setTimeFormat(const QString &format)
+{
+    m_timeFormat = format;
+    scheduleRefresh(DirtyAxes);
+}
+
+int FluentGraphCardWidget::reorderWindow() const { return m_reorderWindow; }
+void FluentGraphCardWidget::setReorderWindow(int msecs)
+{
+    m_reorderWindow = qMax(0, msecs);
+    for (FluentReorderBuffer &buffer : m_reorderBuffers) {
+        buffer.setWindow(m_reorderWindow);
+    }
+}
+
+int FluentGraphCardWidget::maxSlices() const { return m_maxSlices; }
+void FluentGraphCardWidget::setMaxSlices(int slices)
+{
+    if (m_maxSlices == qMax(0, slices)) return;
+
+    // Drill levels were cut for the previous limit
+    m_maxSlices = qMax(0, slices);
+    m_pieDrillStack.clear();
+    m_pieSelector.clear();
+    m_pieSlices = PieSlices();
+    scheduleRefresh(DirtyData);
+}
+
+QStringList FluentGraphCardWidget::foldedCategories() const
+{
+    QStringList names;
+    for (qsizetype index : m_pieSlices.folded) {
+        if (index < m_categories->size()) names << m_categories->at(index);
+    }
+    return names;
+}
+
+int FluentGraphCardWidget::pieDrillLevel() const
+{
+    return int(m_pieDrillStack.size());
+}
+
+void FluentGraphCardWidget::drillIntoOther()
+{
+    if (m_pieSlices.folded.isEmpty()) return;
+
+    // The selection is rebuilt for the narrower scope right away, so a
+    // second call before the next refresh drills one level further
+    m_pieDrillStack.append(m_pieSlices.folded);
+    m_pieSelector.clear();
+    updatePieSlices();
+    scheduleRefresh(DirtyData);
+}
+
+void FluentGraphCardWidget::drillUp()
+{
+    if (m_pieDrillStack.isEmpty()) return;
+
+    m_pieDrillStack.removeLast();
+    m_pieSelector.clear();
+    updatePieSlices();
+    scheduleRefresh(DirtyData);
+}
+
+FluentGraphCardWidget::PieSlices FluentGraphCardWidget::pieSlices(FluentTopNSelector *selector,
+                                                                  const FluentSpan<double> &values,
+                                                                  const QStringList &categories,
+                                                                  const QList<qsizetype> &scope,
+                                                                  int maxSlices)
+{
+    PieSlices slices;
+
+    // One slice per category with a value, or per category of the scope
+    QList<qsizetype> indices = scope;
+    if (indices.isEmpty()) {
+        indices.resize(qMin(values.size(), qsizetype(categories.size())));
+        for (qsizetype i = 0; i < indices.size(); ++i) {
+            indices[i] = i;
+        }
+    }
+
+    // Folding a single category would only rename its slice
+    if (maxSlices <= 0 || indices.size() <= maxSlices + 1) {
+        for (qsizetype index : std::as_const(indices)) {
+            slices.labels << categories.at(index);
+            slices.values << values[index];
+            slices.categories << index;
+        }
+        return slices;
+    }
+
+    // The top level selects straight from the series; a drill level from a
+    // copy of its categories' values
+    QList<double> scoped;
+    const double *data = values.data();
+    if (!scope.isEmpty()) {
+        scoped.resize(scope.size());
+        for (qsizetype i = 0; i < scope.size(); ++i) {
+            scoped[i] = values[scope.at(i)];
+        }
+        data = scoped.constData();
+    }
+    selector->sync(data, indices.size(), maxSlices);
+
+    for (qsizetype i : selector->top()) {
+        slices.labels << categories.at(indices.at(i));
+        slices.values << data[i];
+        slices.categories << indices.at(i);
+    }
+    for (qsizetype i : selector->rest()) {
+        slices.folded << indices.at(i);
+    }
+
+    slices.labels << QStringLiteral("Other");
+    slices.values << selector->restSum();
+    slices.categories << -1;
+    return slices;
+}
+
+void FluentGraphCardWidget::updatePieSlices()
+{
+    if (m_seriesData->isEmpty()) {
+        m_pieSlices = PieSlices();
+        return;
+    }
+
+    // Levels whose categories are gone, after retention or a smaller
+    // reload, are left
+    const FluentSpan<double> values = m_seriesData->yValues(0);
+    const qsizetype count = qMin(values.size(), qsizetype(m_categories->size()));
+    while (!m_pieDrillStack.isEmpty() && m_pieDrillStack.constLast().constLast() >= count) {
+        m_pieDrillStack.removeLast();
+        m_pieSelector.clear();
+    }
+
+    const QList<qsizetype> scope = m_pieDrillStack.isEmpty() ? QList<qsizetype>() : m_pieDrillStack.constLast();
+    m_pieSlices = pieSlices(&m_pieSelector, values, *m_categories, scope, m_maxSlices);
+}
+
+void FluentGraphCardWidget::pieSliceClicked(int slice)
+{
+    if (slice < 0 || slice >= m_pieSlices.categories.size()) return;
+
+    const qsizetype category = m_pieSlices.categories.at(slice);
+    if (category < 0) {
+        emit otherSliceClicked(foldedCategories());
+        drillIntoOther();
+    } else {
+        emit dataPointClicked(m_seriesData->seriesName(0), int(category), m_pieSlices.values.at(slice));
+    }
+}
+
+#ifndef FLUENTWIDGET_NO_QTCHARTS
+void FluentGraphCardWidget::onPieSliceClicked(QPieSlice *slice)
+{
+    if (slice && slice->series()) {
+        pieSliceClicked(int(slice->series()->slices().indexOf(slice)));
+    }
+}
+#endif
+
+int FluentGraphCardWidget::retentionCount() const { return m_seriesStore->retentionCount(); }
+void FluentGraphCardWidget::setRetentionCount(int count)
+{
+    m_seriesStore->setRetentionCount(count);
+}
+
+double FluentGraphCardWidget::retentionSpan() const { return m_seriesStore->retentionSpan(); }
+void FluentGraphCardWidget::setRetentionSpan(double span)
+{
+    m_seriesStore->setRetentionSpan(span);
+}
+
+FluentGraphCardWidget::DecimationMode FluentGraphCardWidget::decimationMode() const { return m_decimationMode; }
+void FluentGraphCardWidget::setDecimationMode(DecimationMode mode)
+{
+    if (m_decimationMode == mode) return;
+
+    m_decimationMode = mode;
+    if (m_chartInitialized) {
+        scheduleRefresh(DirtyData);
+    }
+}
+
+void FluentGraphCardWidget::appendPoint(const QString &series, const QPointF &point)
+{
+    appendPoints(series, &point, 1);
+}
+
+void FluentGraphCardWidget::appendPoints(const QString &series, const QList<QPointF> &points)
+{
+    appendPoints(series, points.constData(), points.size());
+}
+
+void FluentGraphCardWidget::appendPoints(const QString &series, const QPointF *points, qsizetype count)
+{
+    if (series.isEmpty() || !points || count <= 0) return;
+
+    const bool isNewSeries = !m_seriesData->contains(series);
+    const int id = m_seriesData->addSeries(series);
+
+    // Reserve twice the retention window: once points are dropped from the
+    // front, QList reuses the freed head room instead of reallocating, so
+    // each column behaves as a fixed-capacity ring with a contiguous window.
+    const int retention = m_seriesStore->retentionCount();
+    if (isNewSeries && retention > 0) {
+        m_seriesData->reserve(id, 2 * retention);
+    }
+
+    m_seriesData->appendPoints(id, points, count);
+    const qsizetype removed = m_seriesStore->applyRetention(id);
+    m_seriesStore->notifySeriesAppended(id, count, removed);
+}
+
+void FluentGraphCardWidget::appendSample(const QString &series, const QDateTime &time, double value)
+{
+    if (time.isValid()) {
+        appendSample(series, time.toMSecsSinceEpoch(), value);
+    }
+}
+
+void FluentGraphCardWidget::appendSample(const QString &series, qint64 msecsSinceEpoch, double value)
+{
+    if (series.isEmpty()) return;
+
+    auto buffer = m_reorderBuffers.find(series);
+    if (buffer == m_reorderBuffers.end()) {
+        // Nothing may go before what the series already holds
+        qint64 released = std::numeric_limits<qint64>::min();
+        const int id = m_seriesData->seriesId(series);
+        if (id >= 0 && m_seriesData->size(id) > 0) {
+            released = qint64(m_seriesData->xValues(id).last());
+        }
+        buffer = m_reorderBuffers.insert(series, FluentReorderBuffer(m_reorderWindow, released));
+    }
+
+    if (!buffer->insert(msecsSinceEpoch, value)) {
+        ++m_lateSampleCount;
+        return;
+    }
+
+    const QList<FluentReorderBuffer::Sample> ready = buffer->takeReady();
+    if (!buffer->isEmpty()) {
+        m_reorderTimer->start(qMax(m_reorderWindow, 1));
+    }
+    commitSamples(series, ready);
+}
+
+qint64 FluentGraphCardWidget::lateSampleCount() const
+{
+    return m_lateSampleCount;
+}
+
+void FluentGraphCardWidget::flushSamples()
+{
+    m_reorderTimer->stop();
+
+    QList<QPair<QString, QList<FluentReorderBuffer::Sample>>> held;
+    for (auto buffer = m_reorderBuffers.begin(); buffer != m_reorderBuffers.end(); ++buffer) {
+        if (!buffer->isEmpty()) {
+            held.append(qMakePair(buffer.key(), buffer->takeAll()));
+        }
+    }
+    for (const auto &samples : held) {
+        commitSamples(samples.first, samples.second);
+    }
+}
+
+bool FluentGraphCardWidget::appendToChartSeries(int series, qsizetype appended, qsizetype removed)
+{
+#ifdef FLUENTWIDGET_NO_QTCHARTS
+    Q_UNUSED(series)
+    Q_UNUSED(appended)
+    Q_UNUSED(removed)
+    return false;
+#else
+    // A rebuild is already pending and will pick the points up from the table
+    if (m_dirtyFlags & DirtyData) return false;
+
+    // The raster backend has no series to patch, its scene is rebuilt whole
+    QChartView *chartView = qobject_cast<QChartView*>(m_chartView);
+    if (!chartView) return false;
+
+    QChart *chart = chartView->chart();
+    if (!chart) return false;
+
+    if (m_graphType == BarChart || m_graphType == PieChart) {
+        return false;
+    }
+
+    // A decimated or zoomed series no longer maps one-to-one onto the stored
+    // window, so it is reduced again as a whole
+    if (m_viewportZoomed || m_rawIndices.contains(series)
+        || needsDecimation(m_seriesData->size(series))) {
+        return false;
+    }
+
+    // Area charts only render the first series; other series have nothing to update
+    if (m_graphType == AreaChart && series != 0) {
+        return true;
+    }
+
+    const QString name = m_seriesData->seriesName(series);
+    QXYSeries *upperSeries = nullptr;
+    QXYSeries *lowerSeries = nullptr;
+    for (QAbstractSeries *abstractSeries : chart->series()) {
+        if (abstractSeries->name() != name) continue;
+
+        if (QAreaSeries *areaSeries = qobject_cast<QAreaSeries*>(abstractSeries)) {
+            upperSeries = areaSeries->upperSeries();
+            lowerSeries = areaSeries->lowerSeries();
+        } else {
+            upperSeries = qobject_cast<QXYSeries*>(abstractSeries);
+        }
+        break;
+    }
+
+    if (!upperSeries) return false;
+
+    const qsizetype size = m_seriesData->size(series);
+    const qsizetype tail = qMin(appended, size);
+    const bool resync = removed >= upperSeries->count()
+                        || upperSeries->count() - removed + tail != size;
+
+    if (resync) {
+        // The delta no longer lines up with what is on screen; resync the window
+        upperSeries->replace(m_seriesData->points(series));
+    } else {
+        if (removed > 0) {
+            upperSeries->removePoints(0, int(removed));
+        }
+        upperSeries->append(m_seriesData->points(series, size - tail));
+    }
+    invalidateHitTestIndex();
+
+    if (lowerSeries) {
+        const bool resyncBaseline = resync || removed >= lowerSeries->count()
+                                    || lowerSeries->count() - removed + tail != size;
+        const qsizetype from = resyncBaseline ? 0 : size - tail;
+        const FluentSpan<double> x = m_seriesData->xValues(series);
+        QList<QPointF> baseline;
+        baseline.reserve(size - from);
+        for (qsizetype i = from; i < size; ++i) {
+            baseline.append(QPointF(x[i], 0));
+        }
+
+        if (resyncBaseline) {
+            lowerSeries->replace(baseline);
+        } else {
+            if (removed > 0) {
+                lowerSeries->removePoints(0, int(removed));
+            }
+            lowerSeries->append(baseline);
+        }
+    }
+
+    updateAxes();
+    return true;
+#endif
+}
+
+void FluentGraphCardWidget::addDataPoint(const QString &category, double value)
+{
+    addDataPoints(&category, &value, 1);
+}
+
+void FluentGraphCardWidget::addDataPoints(const QStringList &categories, const QList<double> &values)
+{
+    addDataPoints(categories.constData(), values.constData(), qMin(categories.size(), values.size()));
+}
+
+void FluentGraphCardWidget::addDataPoints(const QString *categories, const double *values, qsizetype count)
+{
+    if (!categories || !values || count <= 0) return;
+
+    // Each point goes to the default series at the index of its category,
+    // which the store interns
+    QList<QPointF> points(count);
+    for (qsizetype i = 0; i < count; ++i) {
+        points[i] = QPointF(m_seriesStore->internCategory(categories[i]), values[i]);
+    }
+
+    // appendPoints() grows the columns geometrically; reserving the exact
+    // size here would copy them on every batch
+    const int id = m_seriesData->addSeries("Data");
+    m_seriesData->appendPoints(id, points.constData(), count);
+    m_seriesStore->notifySeriesChanged(id);
+}
+
+void FluentGraphCardWidget::addDataSeries(const QString &name, const QList<QPointF> &points)
+{
+    const int id = m_seriesData->addSeries(name);
+    m_seriesData->setPoints(id, points);
+    m_seriesStore->notifySeriesChanged(id);
+}
+
+void FluentGraphCardWidget::clearData()
+{
+    // Held samples belong to the data being replaced
+    m_reorderBuffers.clear();
+    m_reorderTimer->stop();
+
+    m_seriesData->clear();
+    m_categories->clear();
+    detachDataSources();
+    m_seriesStore->notifyDataReset();
+}
+
+void FluentGraphCardWidget::detachDataSources()
+{
+    // Forget which series the model and the mapped file fed
+    m_modelSeriesIds.clear();
+    m_modelRowCount = -1;
+
+    m_mappedSource.reset();
+    m_mappedSeriesIds.clear();
+    if (m_dataSourceWatcher && !m_dataSourceWatcher->files().isEmpty()) {
+        m_dataSourceWatcher->removePaths(m_dataSourceWatcher->files());
+    }
+}
+
+FluentSeriesStore *FluentGraphCardWidget::seriesStore() const
+{
+    return m_seriesStore;
+}
+
+void FluentGraphCardWidget::setSeriesStore(FluentSeriesStore *store)
+{
+    if (!store) {
+        store = m_localSeriesStore;
+    }
+    if (m_seriesStore == store) return;
+
+    if (m_seriesStore) {
+        disconnect(m_seriesStore, nullptr, this, nullptr);
+    }
+
+    // Loads and file sources in flight were meant for the previous store
+    cancelLoading();
+    detachDataSources();
+
+    m_seriesStore = store;
+    m_seriesData = &store->table();
+    m_categories = &store->categories();
+
+    connect(store, &FluentSeriesStore::seriesAppended, this, &FluentGraphCardWidget::onSeriesAppended);
+    connect(store, &FluentSeriesStore::seriesChanged, this, &FluentGraphCardWidget::onSeriesChanged);
+    connect(store, &FluentSeriesStore::dataReset, this, &FluentGraphCardWidget::onSeriesDataReset);
+
+    // The card's own store is its child and lives as long as the card
+    if (store != m_localSeriesStore) {
+        connect(store, &QObject::destroyed, this, &FluentGraphCardWidget::onSeriesStoreDestroyed);
+    }
+
+    onSeriesDataReset();
+
+    // A bound model is read into the new store
+    scheduleModelReload();
+}
+
+void FluentGraphCardWidget::onSeriesAppended(int id, qsizetype appended, qsizetype removed)
+{
+    const FluentSpan<double> x = m_seriesData->xValues(id);
+    const FluentSpan<double> y = m_seriesData->yValues(id);
+
+    // Keep the level-of-detail pyramid in step with the window
+    auto pyramid = m_lodPyramids.find(id);
+    if (pyramid != m_lodPyramids.end()) {
+        pyramid->sync(x, y, appended, removed);
+    }
+
+    // Overlays take the same points, one running update each
+    const bool overlayFollows = id == m_overlaySourceId;
+    qsizetype overlayAppended = 0;
+    qsizetype overlayRemoved = 0;
+    if (overlayFollows) {
+        const qsizetype tail = qMin(appended, y.size());
+        overlayRemoved = m_overlay.removeBefore(x.isEmpty() ? std::numeric_limits<double>::infinity() : x.first());
+        overlayAppended = m_overlay.append(x.end() - tail, y.end() - tail, tail);
+    }
+
+    // Push only the delta into the live series; anything the incremental path
+    // cannot handle (new series, bar/pie charts) falls back to a rebuild.
+    bool incremental = appendToChartSeries(id, appended, removed);
+#ifndef FLUENTWIDGET_NO_QTCHARTS
+    if (incremental && overlayFollows && showsOverlays()) {
+        incremental = appendToOverlaySeries(overlayAppended, overlayRemoved);
+    }
+#else
+    Q_UNUSED(overlayAppended)
+    Q_UNUSED(overlayRemoved)
+#endif
+    if (!incremental) {
+        scheduleRefresh(DirtyData);
+    }
+}
+
+void FluentGraphCardWidget::onSeriesChanged(int id)
+{
+    m_lodPyramids.remove(id);
+    if (id == m_overlaySourceId) {
+        m_overlaySourceId = -1;
+    }
+    scheduleRefresh(DirtyData);
+}
+
+void FluentGraphCardWidget::onSeriesDataReset()
+{
+    // Any series may be new or gone, so pyramids, overlays and the viewport
+    // start over
+    m_lodPyramids.clear();
+    m_overlaySourceId = -1;
+    m_viewportZoomed = false;
+    m_pieDrillStack.clear();
+    m_pieSelector.clear();
+    scheduleRefresh(DirtyData);
+}
+
+void FluentGraphCardWidget::onSeriesStoreDestroyed()
+{
+    // The shared data went with the store; show the card's own again
+    setSeriesStore(nullptr);
+}
+
+const FluentSeriesTable &FluentGraphCardWidget::seriesData() const
+{
+    return *m_seriesData;
+}
+
+QStringList FluentGraphCardWidget::categories() const
+{
+    return *m_categories;
+}
+
+FluentGraphCardWidget::RenderConfig FluentGraphCardWidget::renderConfig() const
+{
+    RenderConfig config;
+    config.graphType = m_graphType;
+    config.darkMode = m_darkMode;
+    config.accentColor = m_accentColor;
+    config.showLegend = m_showLegend;
+    config.showGrid = m_showGrid;
+    config.decimationMode = m_decimationMode;
+    config.timeSeries = m_timeSeries;
+    config.timeFormat = m_timeFormat;
+    config.maxSlices = m_maxSlices;
+    return config;
+}
+
+void FluentGraphCardWidget::refreshChart()
+{
+    scheduleRefresh(DirtyData);
+}
+
+// File Data Source Implementation
+QString FluentGraphCardWidget::dataSourceFileName(const QString &source)
+{
+    // Accepts file:// URIs as well as plain paths
+    const QUrl url(source);
+    if (url.isLocalFile()) {
+        return url.toLocalFile();
+    }
+    return QFileInfo(source).isFile() ? source : QString();
+}
+
+bool FluentGraphCardWidget::loadDataFromFile(const QString &fileName)
+{
+    if (FluentMappedSeriesFile::isMappedSeriesFile(fileName)) {
+        return loadMappedFile(fileName);
+    }
+    if (FluentCsvReader::isCsvFile(fileName)) {
+        loadCsvFile(fileName);
+        return true;
+    }
+    return false;
+}
+
+bool FluentGraphCardWidget::loadMappedFile(const QString &fileName)
+{
+    QSharedPointer<FluentMappedSeriesFile> file(new FluentMappedSeriesFile(fileName));
+    if (!file->open()) return false;
+
+    cancelLoading();
+    clearData();
+
+    // Series read their columns straight from the mapping; columns with a
+    // name that is already taken are skipped
+    for (int i = 0; i < file->seriesCount(); ++i) {
+        const QString name = file->seriesName(i);
+        if (m_seriesData->contains(name)) {
+            m_mappedSeriesIds.append(-1);
+            continue;
+        }
+
+        const int id = m_seriesData->addSeries(name);
+        m_seriesData->setMappedColumns(id, file->xValues(), file->yValues(i), file);
+        m_seriesStore->applyRetention(id);
+        m_mappedSeriesIds.append(id);
+    }
+
+    m_mappedSource = file;
+    m_dataSourceWatcher->addPath(fileName);
+
+    m_seriesStore->notifyDataReset();
+    return true;
+}
+
+void FluentGraphCardWidget::onDataSourceFileChanged(const QString &path)
+{
+    if (!m_mappedSource || path != m_mappedSource->fileName()) return;
+
+    // Writers that replace the file drop it from the watcher
+    if (!m_dataSourceWatcher->files().contains(path) && QFileInfo::exists(path)) {
+        m_dataSourceWatcher->addPath(path);
+    }
+
+    const qsizetype previous = m_mappedSource->rowCount();
+    bool incremental = m_mappedSource->refresh();
+    for (int id : m_mappedSeriesIds) {
+        incremental = incremental && (id < 0 || m_seriesData->isMapped(id));
+    }
+
+    // A new layout, or series that have been written to since, are read again
+    if (!incremental) {
+        loadMappedFile(path);
+        return;
+    }
+
+    const qsizetype rowCount = m_mappedSource->rowCount();
+    const qsizetype appended = rowCount - previous;
+    if (appended == 0) return;
+
+    // Widen every window by the new rows, keeping what retention dropped
+    const FluentSpan<double> x = m_mappedSource->xValues();
+    for (int i = 0; i < m_mappedSeriesIds.size(); ++i) {
+        const int id = m_mappedSeriesIds.at(i);
+        if (id < 0) continue;
+
+        const qsizetype dropped = previous - m_seriesData->size(id);
+        const FluentSpan<double> y = m_mappedSource->yValues(i);
+        m_seriesData->setMappedColumns(id, x.subspan(dropped, rowCount - dropped),
+                                      y.subspan(dropped, rowCount - dropped), m_mappedSource);
+        const qsizetype removed = m_seriesStore->applyRetention(id);
+        m_seriesStore->notifySeriesAppended(id, appended, removed);
+    }
+}
+
+void FluentGraphCardWidget::loadCsvFile(const QString &fileName)
+{
+    // The chart keeps showing the previous data until the file is read
+    cancelLoading();
+    m_csvLoadClock.start();
+    m_csvLoadWatcher->setFuture(QtConcurrent::run(readCsvFile, fileName));
+}
+
+void FluentGraphCardWidget::applyCsvColumns(const FluentCsvColumns &columns)
+{
+    clearData();
+    *m_categories = columns.categories;
+
+    // Columns move into the series as they are; series without gaps share
+    // the rows column
+    for (int i = 0; i < columns.y.size(); ++i) {
+        if (columns.y[i].isEmpty()) continue;
+
+        const int id = m_seriesData->addSeries(columns.seriesNames[i]);
+        m_seriesData->setColumns(id, columns.x[i].isEmpty() ? columns.rows : columns.x[i], columns.y[i]);
+        m_seriesStore->applyRetention(id);
+    }
+
+    m_seriesStore->notifyDataReset();
+
+    emit dataLoaded(int(columns.rows.size()), 0, m_csvLoadClock.elapsed());
+}
+
+void FluentGraphCardWidget::onCsvLoadFinished()
+{
+    // Cancelled, failed and superseded reads leave the data as it was
+    if (!m_csvLoadWatcher->isFinished() || m_csvLoadWatcher->isCanceled()
+        || m_csvLoadWatcher->future().resultCount() == 0) {
+        return;
+    }
+
+    applyCsvColumns(m_csvLoadWatcher->result());
+
+    // Drop the future's reference so the columns are only held by the series
+    m_csvLoadWatcher->setFuture(QFuture<FluentCsvColumns>());
+}
+
+bool FluentGraphCardWidget::isLoadingFile() const
+{
+    return m_csvLoadWatcher && m_csvLoadWatcher->isRunning();
+}
+
+void FluentGraphCardWidget::cancelLoading()
+{
+    // A file being read stops at its next chunk; a model conversion runs to
+    // the end but its result is dropped
+    if (m_csvLoadWatcher && m_csvLoadWatcher->isRunning()) {
+        m_csvLoadWatcher->cancel();
+    }
+    ++m_modelLoadGeneration;
+}
+
+// Data Model Support Implementation
+void FluentGraphCardWidget::setDataModel(QAbstractItemModel *model)
+{
+    if (m_dataModel) {
+        disconnect(m_dataModel, nullptr, this, nullptr);
+    }
+
+    m_dataModel = model;
+    clearModelChanges();
+
+    if (m_dataModel) {
+        connect(m_dataModel, &QAbstractItemModel::dataChanged, this, &FluentGraphCardWidget::onModelDataChanged);
+        connect(m_dataModel, &QAbstractItemModel::modelReset, this, &FluentGraphCardWidget::onModelReset);
+        connect(m_dataModel, &QAbstractItemModel::rowsInserted, this, &FluentGraphCardWidget::onModelRowsInserted);
+        connect(m_dataModel, &QAbstractItemModel::rowsRemoved, this, &FluentGraphCardWidget::onModelRowsChanged);
+
+        // Column setters usually follow; they all share one load
+        scheduleModelReload();
+    } else {
+        loadSampleData();
+    }
+}
+
+QAbstractItemModel *FluentGraphCardWidget::dataModel() const
+{
+    return m_dataModel;
+}
+
+void FluentGraphCardWidget::setXColumn(int column)
+{
+    m_xColumn = column;
+    scheduleModelReload();
+}
+
+void FluentGraphCardWidget::setYColumns(const QList<int> &columns)
+{
+    m_yColumns = columns;
+    scheduleModelReload();
+}
+
+void FluentGraphCardWidget::setSeriesNamesColumn(int column)
+{
+    m_seriesNamesColumn = column;
+    scheduleModelReload();
+}
+
+int FluentGraphCardWidget::maxModelUpdateRate() const { return m_maxModelUpdateRate; }
+void FluentGraphCardWidget::setMaxModelUpdateRate(int rate)
+{
+    m_maxModelUpdateRate = qMax(0, rate);
+}
+
+bool FluentGraphCardWidget::isAsyncModelLoading() const { return m_asyncModelLoading; }
+void FluentGraphCardWidget::setAsyncModelLoading(bool async)
+{
+    m_asyncModelLoading = async;
+}
+
+bool FluentGraphCardWidget::isLoadingModel() const
+{
+    return m_modelLoadWatcher && m_modelLoadWatcher->isRunning();
+}
+
+void FluentGraphCardWidget::loadDataFromModel()
+{
+    FLUENT_PERF_SCOPE(ModelLoad);
+    // Every load supersedes the ones still converting or reading a file
+    cancelLoading();
+
+    if (!m_dataModel || m_dataModel->rowCount() == 0 || m_yColumns.isEmpty()) {
+        loadSampleData();
+        return;
+    }
+
+    const ModelSnapshot snapshot = takeModelSnapshot();
+
+    if (m_asyncModelLoading) {
+        m_modelLoadWatcher->setFuture(QtConcurrent::run(&FluentGraphCardWidget::convertModelSnapshot, snapshot));
+    } else {
+        applyModelColumns(convertModelSnapshot(snapshot));
+    }
+}
+
+FluentGraphCardWidget::ModelSnapshot FluentGraphCardWidget::takeModelSnapshot() const
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    ModelSnapshot snapshot;
+    snapshot.generation = m_modelLoadGeneration;
+    snapshot.rowCount = m_dataModel->rowCount();
+    snapshot.timeSeries = m_timeSeries;
+
+    // Only the cells are copied here, converting them is left to
+    // convertModelSnapshot()
+    snapshot.categories.reserve(snapshot.rowCount);
+    for (int row = 0; row < snapshot.rowCount; ++row) {
+        snapshot.categories.append(m_dataModel->data(m_dataModel->index(row, m_xColumn)));
+    }
+
+    for (int i = 0; i < m_yColumns.size(); ++i) {
+        int yColumn = m_yColumns[i];
+        QString seriesName;
+
+        // Get series name from header or dedicated column
+        if (m_seriesNamesColumn >= 0 && i < snapshot.rowCount) {
+            QModelIndex nameIndex = m_dataModel->index(i, m_seriesNamesColumn);
+            seriesName = m_dataModel->data(nameIndex).toString();
+        }
+
+        if (seriesName.isEmpty()) {
+            seriesName = m_dataModel->headerData(yColumn, Qt::Horizontal).toString();
+            if (seriesName.isEmpty()) {
+                seriesName = QString("Series %1").arg(i + 1);
+            }
+        }
+        snapshot.seriesNames.append(seriesName);
+
+        QList<QVariant> cells;
+        cells.reserve(snapshot.rowCount);
+        for (int row = 0; row < snapshot.rowCount; ++row) {
+            cells.append(m_dataModel->data(m_dataModel->index(row, yColumn)));
+        }
+        snapshot.columns.append(cells);
+    }
+
+    snapshot.snapshotMsecs = timer.elapsed();
+    return snapshot;
+}
+
+FluentGraphCardWidget::ModelColumns FluentGraphCardWidget::convertModelSnapshot(const ModelSnapshot &snapshot)
+{
+    // Runs on a worker thread in async mode: touches nothing but the snapshot
+    QElapsedTimer timer;
+    timer.start();
+
+    ModelColumns columns;
+    columns.generation = snapshot.generation;
+    columns.rowCount = snapshot.rowCount;
+    columns.snapshotMsecs = snapshot.snapshotMsecs;
+    columns.seriesNames = snapshot.seriesNames;
+
+    // Model row behind each x value, when it isn't simply the row number
+    QList<int> order;
+    columns.rowsInOrder = true;
+
+    if (snapshot.timeSeries) {
+        // Rows are placed by the time in the X column; rows without one are
+        // left out and the rest sorted, so series can be searched by time
+        QList<QPair<qint64, int>> times;
+        times.reserve(snapshot.categories.size());
+        for (int row = 0; row < snapshot.categories.size(); ++row) {
+            qint64 msecs = 0;
+            if (toModelTime(snapshot.categories[row], &msecs)) {
+                times.append(qMakePair(msecs, row));
+            }
+        }
+
+        auto earlier = [](const QPair<qint64, int> &a, const QPair<qint64, int> &b) { return a.first < b.first; };
+        const bool sorted = std::is_sorted(times.cbegin(), times.cend(), earlier);
+        if (!sorted) {
+            std::stable_sort(times.begin(), times.end(), earlier);
+        }
+        columns.rowsInOrder = sorted && times.size() == snapshot.rowCount;
+
+        columns.rows.reserve(times.size());
+        order.reserve(times.size());
+        for (const QPair<qint64, int> &time : times) {
+            columns.rows.append(double(time.first));
+            order.append(time.second);
+        }
+    } else {
+        // Categories from the X column
+        for (const QVariant &cell : snapshot.categories) {
+            QString category = cell.toString();
+            if (!category.isEmpty()) {
+                columns.categories.append(category);
+            }
+        }
+
+        // Row numbers are the x values of every series
+        columns.rows.reserve(snapshot.rowCount);
+        for (int row = 0; row < snapshot.rowCount; ++row) {
+            columns.rows.append(row);
+        }
+    }
+
+    // Columns without gaps all share the one x column
+    for (const QList<QVariant> &cells : snapshot.columns) {
+        QList<double> xValues;
+        QList<double> yValues;
+        yValues.reserve(columns.rows.size());
+        bool hasGaps = false;
+        for (qsizetype i = 0; i < columns.rows.size(); ++i) {
+            const int row = order.isEmpty() ? int(i) : order[i];
+            double value = 0.0;
+            if (row < cells.size() && toModelValue(cells[row], &value)) {
+                yValues.append(value);
+                if (hasGaps) {
+                    xValues.append(columns.rows[i]);
+                }
+            } else if (!hasGaps) {
+                // First unusable cell: this series gets its own x column
+                hasGaps = true;
+                xValues = columns.rows.mid(0, yValues.size());
+            }
+        }
+
+        columns.x.append(xValues);
+        columns.y.append(yValues);
+    }
+
+    columns.conversionMsecs = timer.elapsed();
+    return columns;
+}
+
+bool FluentGraphCardWidget::toModelValue(const QVariant &variant, double *value)
+{
+    // Unreadable cells and NaN are left out of the series
+    bool ok = false;
+    *value = variant.toDouble(&ok);
+    return ok && !std::isnan(*value);
+}
+
+bool FluentGraphCardWidget::toModelTime(const QVariant &variant, qint64 *msecs)
+{
+    // Date and date/time cells, ISO 8601 text, or numbers taken as
+    // milliseconds since the epoch
+    qint64 time = 0;
+    const int type = variant.typeId();
+    if (type == QMetaType::QDateTime || type == QMetaType::QDate) {
+        const QDateTime dateTime = variant.toDateTime();
+        if (!dateTime.isValid()) return false;
+        time = dateTime.toMSecsSinceEpoch();
+    } else if (type == QMetaType::QString) {
+        const QString text = variant.toString();
+        bool ok = false;
+        time = text.toLongLong(&ok);
+        if (!ok) {
+            const QDateTime dateTime = QDateTime::fromString(text, Qt::ISODateWithMs);
+            if (!dateTime.isValid()) return false;
+            time = dateTime.toMSecsSinceEpoch();
+        }
+    } else {
+        bool ok = false;
+        const double value = variant.toDouble(&ok);
+        if (!ok || !(std::fabs(value) <= kMaxExactMsecs)) return false;
+        time = qint64(std::floor(value));
+    }
+
+    // Beyond this the double x columns could not hold the time exactly
+    if (time < -kMaxExactMsecs || time > kMaxExactMsecs) return false;
+
+    *msecs = time;
+    return true;
+}
+
+void FluentGraphCardWidget::applyModelColumns(const ModelColumns &columns)
+{
+    clearData();
+    *m_categories = columns.categories;
+
+    for (int i = 0; i < columns.y.size(); ++i) {
+        int id = -1;
+        if (!columns.y[i].isEmpty()) {
+            id = m_seriesData->addSeries(columns.seriesNames[i]);
+            m_seriesData->setColumns(id, columns.x[i].isEmpty() ? columns.rows : columns.x[i], columns.y[i]);
+
+            // A later column with the same name replaces the earlier one
+            for (int &seriesId : m_modelSeriesIds) {
+                if (seriesId == id) seriesId = -1;
+            }
+        }
+        m_modelSeriesIds.append(id);
+    }
+
+    m_modelRowCount = columns.rowCount;
+    m_modelRowsInOrder = columns.rowsInOrder;
+    m_seriesStore->notifyDataReset();
+
+    emit dataLoaded(columns.rowCount, columns.snapshotMsecs, columns.conversionMsecs);
+}
+
+void FluentGraphCardWidget::onModelLoadFinished()
+{
+    const ModelColumns columns = m_modelLoadWatcher->result();
+
+    // Results of superseded loads are dropped
+    if (columns.generation == m_modelLoadGeneration) {
+        applyModelColumns(columns);
+    }
+
+    // Changes that arrived while converting were held back until now
+    if (m_modelReloadPending || m_modelAppendPending || m_dirtyFirstRow >= 0) {
+        scheduleModelFlush();
+    }
+}
+
+void FluentGraphCardWidget::onModelDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight)
+{
+    if (!topLeft.isValid() || !bottomRight.isValid()) {
+        m_modelReloadPending = true;
+    } else if (!topLeft.parent().isValid()) {
+        // Grow the dirty rectangle; only top-level rows feed the chart
+        if (m_dirtyFirstRow < 0) {
+            m_dirtyFirstRow = topLeft.row();
+            m_dirtyLastRow = bottomRight.row();
+            m_dirtyFirstColumn = topLeft.column();
+            m_dirtyLastColumn = bottomRight.column();
+        } else {
+            m_dirtyFirstRow = qMin(m_dirtyFirstRow, topLeft.row());
+            m_dirtyLastRow = qMax(m_dirtyLastRow, bottomRight.row());
+            m_dirtyFirstColumn = qMin(m_dirtyFirstColumn, topLeft.column());
+            m_dirtyLastColumn = qMax(m_dirtyLastColumn, bottomRight.column());
+        }
+    } else {
+        return;
+    }
+
+    scheduleModelFlush();
+}
+
+void FluentGraphCardWidget::onModelRowsInserted(const QModelIndex &parent, int first, int last)
+{
+    if (parent.isValid()) return;
+
+    // Rows added at the end are read on their own, anything else reloads
+    if (m_modelRowCount >= 0 && first >= m_modelRowCount && last == m_dataModel->rowCount() - 1) {
+        m_modelAppendPending = true;
+    } else {
+        m_modelReloadPending = true;
+    }
+
+    scheduleModelFlush();
+}
+
+void FluentGraphCardWidget::onModelRowsChanged()
+{
+    m_modelReloadPending = true;
+    scheduleModelFlush();
+}
+
+void FluentGraphCardWidget::onModelReset()
+{
+    m_modelReloadPending = true;
+    scheduleModelFlush();
+}
+
+void FluentGraphCardWidget::scheduleModelFlush()
+{
+    if (m_modelFlushTimer->isActive()) return;
+
+    // Without a rate limit changes are applied on the next event loop turn
+    int delay = 0;
+    if (m_maxModelUpdateRate > 0 && m_modelFlushClock.isValid()) {
+        const qint64 interval = 1000 / m_maxModelUpdateRate;
+        delay = int(qMax(qint64(0), interval - m_modelFlushClock.elapsed()));
+    }
+    m_modelFlushTimer->start(delay);
+}
+
+void FluentGraphCardWidget::scheduleModelReload()
+{
+    if (!m_dataModel) return;
+
+    m_modelReloadPending = true;
+    scheduleModelFlush();
+}
+
+void FluentGraphCardWidget::clearModelChanges()
+{
+    if (m_modelFlushTimer) {
+        m_modelFlushTimer->stop();
+    }
+    m_modelReloadPending = false;
+    m_modelAppendPending = false;
+    m_dirtyFirstRow = -1;
+    m_dirtyLastRow = -1;
+    m_dirtyFirstColumn = -1;
+    m_dirtyLastColumn = -1;
+}
+
+void FluentGraphCardWidget::flushModelChanges()
+{
+    // A load in flight doesn't know about these changes yet; they are applied
+    // on top of its result
+    if (isLoadingModel()) return;
+
+    m_modelFlushClock.start();
+
+    const bool reload = m_modelReloadPending;
+    const bool append = m_modelAppendPending;
+    const int firstRow = m_dirtyFirstRow;
+    const int lastRow = m_dirtyLastRow;
+    const int firstColumn = m_dirtyFirstColumn;
+    const int lastColumn = m_dirtyLastColumn;
+    clearModelChanges();
+
+    if (!m_dataModel) return;
+
+    if (reload || (append && !appendModelRows())
+        || !updateModelRows(firstRow, lastRow, firstColumn, lastColumn)) {
+        loadDataFromModel();
+    }
+}
+
+bool FluentGraphCardWidget::appendModelRows()
+{
+    // Reads the rows past m_modelRowCount into the series; returns false when
+    // the change can only be handled by a full reload
+    const int rowCount = m_dataModel->rowCount();
+    const int firstRow = m_modelRowCount;
+    if (firstRow < 0 || rowCount < firstRow) return false;
+    if (rowCount == firstRow) return true;
+
+    // The new rows may carry series names that weren't there before
+    if (m_seriesNamesColumn >= 0 && firstRow < m_yColumns.size()) return false;
+
+    const qsizetype count = rowCount - firstRow;
+    QList<double> rows;
+    rows.reserve(count);
+    if (m_timeSeries) {
+        // New rows only go at the end while every row keeps its time in order
+        if (!m_modelRowsInOrder) return false;
+
+        double lastTime = -std::numeric_limits<double>::infinity();
+        for (int id : m_modelSeriesIds) {
+            if (id >= 0 && m_seriesData->size(id) > 0) {
+                lastTime = qMax(lastTime, m_seriesData->xValues(id).last());
+            }
+        }
+
+        for (int row = firstRow; row < rowCount; ++row) {
+            qint64 msecs = 0;
+            if (!toModelTime(m_dataModel->data(m_dataModel->index(row, m_xColumn)), &msecs)) return false;
+            if (double(msecs) < lastTime) return false;
+            rows.append(double(msecs));
+            lastTime = double(msecs);
+        }
+    } else {
+        for (int row = firstRow; row < rowCount; ++row) {
+            rows.append(row);
+        }
+    }
 
-    // Configure axes if they exist
-    auto horizontalAxes = chart->axes(Qt::Horizontal);
-    auto verticalAxes = chart->axes(Qt::Vertical);
+    // Read the new cells first; a column that had no series so far would
+    // need one inserted in order, which only a reload does
+    QList<QList<double>> values(m_yColumns.size());
+    QList<QList<bool>> readable(m_yColumns.size());
+    QList<bool> complete(m_yColumns.size(), true);
+    for (int i = 0; i < m_yColumns.size(); ++i) {
+        values[i].reserve(count);
+        readable[i].reserve(count);
+        for (int row = firstRow; row < rowCount; ++row) {
+            double value = 0.0;
+            const bool ok = toModelValue(m_dataModel->data(m_dataModel->index(row, m_yColumns[i])), &value);
+            if (ok && m_modelSeriesIds.value(i, -1) < 0) return false;
+            values[i].append(value);
+            readable[i].append(ok);
+            complete[i] = complete[i] && ok;
+        }
+    }
 
-    for (auto axis : horizontalAxes) {
-        if (QValueAxis *valueAxis = qobject_cast<QValueAxis*>(axis)) {
-            valueAxis->setGridLineVisible(m_showGrid);
+    for (int row = firstRow; row < rowCount && !m_timeSeries; ++row) {
+        QString category = m_dataModel->data(m_dataModel->index(row, m_xColumn)).toString();
+        if (!category.isEmpty()) {
+            m_categories->append(category);
         }
     }
 
-    for (auto axis : verticalAxes) {
-        if (QValueAxis *valueAxis = qobject_cast<QValueAxis*>(axis)) {
-            valueAxis->setGridLineVisible(m_showGrid);
+    // Gap-free series keep sharing the row number column; the others append
+    // their readable cells one by one
+    QList<int> sharedIds;
+    QList<qsizetype> appended(m_yColumns.size(), 0);
+    for (int i = 0; i < m_yColumns.size(); ++i) {
+        const int id = m_modelSeriesIds.value(i, -1);
+        if (id < 0) continue;
+
+        if (complete[i] && m_seriesData->size(id) == firstRow) {
+            sharedIds.append(id);
+            m_seriesData->appendYValues(id, values[i].constData(), count);
+            appended[i] = count;
+        } else {
+            for (qsizetype k = 0; k < count; ++k) {
+                if (readable[i][k]) {
+                    m_seriesData->appendPoint(id, rows[k], values[i][k]);
+                    ++appended[i];
+                }
+            }
+        }
+    }
+    m_seriesData->appendSharedXValues(sharedIds, rows.constData(), count);
+    m_modelRowCount = rowCount;
+
+    // Same delta path as appendPoints(), one series at a time
+    for (int i = 0; i < m_modelSeriesIds.size(); ++i) {
+        const int id = m_modelSeriesIds.at(i);
+        if (id >= 0 && appended[i] > 0) {
+            m_seriesStore->notifySeriesAppended(id, appended[i], 0);
         }
     }
+    return true;
 }
 
-void FluentGraphCardWidget::loadSampleData()
+bool FluentGraphCardWidget::updateModelRows(int firstRow, int lastRow, int firstColumn, int lastColumn)
 {
-    clearData();
+    // Re-reads the dirty cells in place; returns false when the change can
+    // only be handled by a full reload
+    if (firstRow < 0) return true;
 
-    // Add sample categories
-    m_categories << "Jan" << "Feb" << "Mar" << "Apr" << "May" << "Jun";
-    m_seriesNames.clear();
+    auto isDirty = [&](int column) { return column >= firstColumn && column <= lastColumn; };
 
-    // Generate sample data based on chart type
-    switch (m_graphType) {
-        case LineChart:
-        case ScatterChart:
-        case AreaChart: {
-            QList<QPointF> series1, series2;
-            for (int i = 0; i < 6; ++i) {
-                series1.append(QPointF(i, QRandomGenerator::global()->bounded(20, 80)));
-                series2.append(QPointF(i, QRandomGenerator::global()->bounded(10, 60)));
+    // Series names are read from the first rows of the names column
+    if (m_seriesNamesColumn >= 0 && isDirty(m_seriesNamesColumn) && firstRow < m_yColumns.size()) {
+        return false;
+    }
+
+    // Time series rows map onto points only while they were kept in model
+    // order, and a new time may move a row
+    if (m_timeSeries && (!m_modelRowsInOrder || isDirty(m_xColumn))) return false;
+
+    const int rowCount = m_dataModel->rowCount();
+    lastRow = qMin(lastRow, rowCount - 1);
+
+    bool categoriesChanged = false;
+
+    if (isDirty(m_xColumn) && firstRow <= lastRow) {
+        // Categories map onto rows only while every row has one
+        if (m_categories->size() != rowCount) return false;
+
+        for (int row = firstRow; row <= lastRow; ++row) {
+            const QString category = m_dataModel->data(m_dataModel->index(row, m_xColumn)).toString();
+            if (category.isEmpty()) return false;
+            if (m_categories->at(row) != category) {
+                (*m_categories)[row] = category;
+                categoriesChanged = true;
             }
-            m_seriesData["Revenue"] = series1;
-            m_seriesData["Expenses"] = series2;
-            m_seriesNames << "Revenue" << "Expenses";
-            break;
         }
-        case BarChart: {
-            QList<QPointF> series1, series2;
-            for (int i = 0; i < 6; ++i) {
-                series1.append(QPointF(i, QRandomGenerator::global()->bounded(10, 50)));
-                series2.append(QPointF(i, QRandomGenerator::global()->bounded(5, 30)));
+    }
+
+    for (int i = 0; i < m_yColumns.size() && firstRow <= lastRow; ++i) {
+        if (!isDirty(m_yColumns[i])) continue;
+
+        // Series with unreadable cells don't map rows onto indices one to one
+        const int id = m_modelSeriesIds.value(i, -1);
+        if (id < 0 || m_seriesData->size(id) != rowCount) return false;
+
+        bool changed = false;
+        for (int row = firstRow; row <= lastRow; ++row) {
+            double value = 0.0;
+            if (!toModelValue(m_dataModel->data(m_dataModel->index(row, m_yColumns[i])), &value)) return false;
+            if (m_seriesData->yValues(id)[row] != value) {
+                m_seriesData->setYValue(id, row, value);
+                changed = true;
             }
-            m_seriesData["Sales"] = series1;
-            m_seriesData["Target"] = series2;
-            m_seriesNames << "Sales" << "Target";
-            break;
         }
-        case PieChart: {
-            QList<QPointF> series1;
-            series1.append(QPointF(0, 30));
-            series1.append(QPointF(1, 25));
-            series1.append(QPointF(2, 20));
-            series1.append(QPointF(3, 15));
-            series1.append(QPointF(4, 10));
-            m_seriesData["Distribution"] = series1;
-            m_categories.clear();
-            m_categories << "Category A" << "Category B" << "Category C" << "Category D" << "Category E";
-            break;
+
+        if (changed) {
+            m_seriesStore->notifySeriesChanged(id);
         }
     }
 
-    refreshChart();
+    if (categoriesChanged) {
+        m_seriesStore->notifyDataReset();
+    }
+    return true;
 }
 
-// Property implementations
-QString FluentGraphCardWidget::title() const { return m_title; }
-void FluentGraphCardWidget::setTitle(const QString &title)
+// Decimation
+int FluentGraphCardWidget::decimationBucketCount() const
 {
-    m_title = title;
-    if (m_titleLabel) m_titleLabel->setText(title);
+    if (!m_chartView) return 0;
+
+    // Coarse quality spends a quarter of the points on the same width
+    const int pixelsPerBucket = m_renderQuality >= CoarseQuality ? 4 : 1;
+
+    // Before the first layout the plot area is empty; the view width is a
+    // close enough upper bound until then
+    const int plotWidth = qRound(plotAreaRect().width());
+    return qMax((plotWidth > 0 ? plotWidth : m_chartView->width()) / pixelsPerBucket, 1);
 }
 
-QString FluentGraphCardWidget::subtitle() const { return m_subtitle; }
-void FluentGraphCardWidget::setSubtitle(const QString &subtitle)
+bool FluentGraphCardWidget::needsDecimation(qsizetype count) const
 {
-    m_subtitle = subtitle;
-    if (m_subtitleLabel) m_subtitleLabel->setText(subtitle);
+    switch (m_decimationMode) {
+        case LTTBDecimation:
+            return count > qMax(m_decimationBuckets, 3);
+        case MinMaxEnvelopeDecimation:
+            return count > 2 * qMax(m_decimationBuckets, 1);
+        case NoDecimation:
+            break;
+    }
+    return false;
 }
 
-FluentGraphCardWidget::GraphType FluentGraphCardWidget::graphType() const { return m_graphType; }
-void FluentGraphCardWidget::setGraphType(GraphType type)
+QList<QPointF> FluentGraphCardWidget::decimatedPoints(int series)
 {
-    if (m_graphType == type) return;
+    const FluentSpan<double> x = m_seriesData->xValues(series);
+    const FluentSpan<double> y = m_seriesData->yValues(series);
+
+    // Only the visible x-range is handed to the chart
+    const QPair<qsizetype, qsizetype> range = visibleIndexRange(series);
+    const qsizetype count = range.second - range.first;
+
+    if (!needsDecimation(count)) {
+        if (count == y.size()) {
+            m_rawIndices.remove(series);
+        } else {
+            QList<qsizetype> rawIndices;
+            rawIndices.reserve(count);
+            for (qsizetype i = range.first; i < range.second; ++i) {
+                rawIndices.append(i);
+            }
+            m_rawIndices.insert(series, rawIndices);
+        }
+        return m_seriesData->points(series, range.first, count);
+    }
 
-    m_graphType = type;
+    // The pyramid answers the min/max envelope in O(pixels); LTTB then picks
+    // its points from that envelope rather than from every raw sample
+    QList<qsizetype> rawIndices;
+    QList<QPointF> decimated = lodPyramid(series).envelope(x, y, range.first, range.second,
+                                                           m_decimationBuckets, &rawIndices);
 
-    // Only update if the widget is fully initialized
-    if (m_chartInitialized && m_chartView) {
-        // Ensure we have appropriate data for the new chart type
-        if (m_seriesData.isEmpty() ||
-            (type == PieChart && m_categories.isEmpty())) {
-            loadSampleData();
-        }
-        updateChart();
+    if (m_decimationMode == LTTBDecimation) {
+        decimated = lttbFromEnvelope(decimated, m_decimationBuckets, &rawIndices);
     }
-}
 
-bool FluentGraphCardWidget::showLegend() const { return m_showLegend; }
-void FluentGraphCardWidget::setShowLegend(bool show)
-{
-    m_showLegend = show;
-    applyChartTheme();
+    m_rawIndices.insert(series, rawIndices);
+    return decimated;
 }
 
-bool FluentGraphCardWidget::showGrid() const { return m_showGrid; }
-void FluentGraphCardWidget::setShowGrid(bool show)
+// The envelope has already skipped non-finite values and kept the spikes,
+// so LTTB only chooses among those points. rawIndices, when given, holds
+// the raw index of every envelope point and is mapped to the chosen ones.
+QList<QPointF> FluentGraphCardWidget::lttbFromEnvelope(const QList<QPointF> &envelope, qsizetype buckets,
+                                                       QList<qsizetype> *rawIndices)
 {
-    m_showGrid = show;
-    updateChart();
-}
+    if (!rawIndices) {
+        return FluentChartDecimator::lttb(envelope.constData(), envelope.size(), buckets);
+    }
 
-bool FluentGraphCardWidget::isDarkMode() const { return m_darkMode; }
-void FluentGraphCardWidget::setDarkMode(bool dark)
-{
-    m_darkMode = dark;
-    updateTheme();
+    QList<qsizetype> envelopeIndices;
+    const QList<QPointF> points = FluentChartDecimator::lttb(envelope.constData(), envelope.size(), buckets,
+                                                             &envelopeIndices);
+    for (qsizetype &index : envelopeIndices) {
+        index = rawIndices->at(index);
+    }
+    *rawIndices = envelopeIndices;
+    return points;
 }
 
-QColor FluentGraphCardWidget::accentColor() const { return m_accentColor; }
-void FluentGraphCardWidget::setAccentColor(const QColor &color)
+int FluentGraphCardWidget::rawPointIndex(int series, int index) const
 {
-    m_accentColor = color;
-    updateChart();
+    auto it = m_rawIndices.constFind(series);
+    if (it == m_rawIndices.constEnd()) {
+        return index;
+    }
+    return index >= 0 && index < it.value().size() ? int(it.value().at(index)) : -1;
 }
 
-QString FluentGraphCardWidget::dataSource() const { return m_dataSource; }
-void FluentGraphCardWidget::setDataSource(const QString &source)
+void FluentGraphCardWidget::updateDecimation()
 {
-    m_dataSource = source;
-
-    // If we have a data model, try to load from it
-    if (m_dataModel) {
-        loadDataFromModel();
-    } else {
-        // Fallback to sample data
-        loadSampleData();
+    if (m_decimationMode == NoDecimation) return;
+
+    const int buckets = decimationBucketCount();
+    if (buckets == m_decimationBuckets) return;
+
+    // Only series long enough to be reduced at either width look different
+    const int smaller = qMin(buckets, m_decimationBuckets);
+    const qsizetype threshold = m_decimationMode == MinMaxEnvelopeDecimation ? 2 * qsizetype(smaller) : smaller;
+    for (int id = 0; id < m_seriesData->seriesCount(); ++id) {
+        if (m_seriesData->size(id) > threshold) {
+            scheduleRefresh(DirtyData);
+            return;
+        }
     }
+
+    m_decimationBuckets = buckets;
 }
 
-bool FluentGraphCardWidget::isAnimated() const { return m_animated; }
-void FluentGraphCardWidget::setAnimated(bool animated)
+// Level of detail, zoom and pan
+FluentLodPyramid &FluentGraphCardWidget::lodPyramid(int series)
 {
-    m_animated = animated;
-    QChartView *chartView = qobject_cast<QChartView*>(m_chartView);
-    if (chartView) {
-        QChart *chart = chartView->chart();
-        if (chart) {
-            chart->setAnimationOptions(animated ? QChart::AllAnimations : QChart::NoAnimation);
-        }
+    // Built on first use and kept in step by appendPoints() afterwards
+    FluentLodPyramid &pyramid = m_lodPyramids[series];
+    if (pyramid.size() != m_seriesData->size(series)) {
+        pyramid.rebuild(m_seriesData->xValues(series), m_seriesData->yValues(series));
     }
+    return pyramid;
 }
 
-void FluentGraphCardWidget::addDataPoint(const QString &category, double value)
+QPair<qsizetype, qsizetype> FluentGraphCardWidget::visibleIndexRange(int series)
 {
-    if (!m_categories.contains(category)) {
-        m_categories.append(category);
+    const FluentSpan<double> x = m_seriesData->xValues(series);
+    const qsizetype count = x.size();
+    if (!m_viewportZoomed || count == 0) {
+        return qMakePair(qsizetype(0), count);
     }
 
-    // Add to default series
-    if (!m_seriesData.contains("Data")) {
-        m_seriesData["Data"] = QList<QPointF>();
-        m_seriesNames << "Data";
+    // Unordered x values can't be searched; the axis range clips them instead
+    if (!lodPyramid(series).isSorted()) {
+        return qMakePair(qsizetype(0), count);
     }
 
-    int index = m_categories.indexOf(category);
-    m_seriesData["Data"].append(QPointF(index, value));
+    const double *first = std::lower_bound(x.begin(), x.end(), m_viewMinX);
+    const double *last = std::upper_bound(first, x.end(), m_viewMaxX);
+
+    // One extra point on either side so lines run to the edge of the plot
+    const qsizetype begin = qMax(qsizetype(0), qsizetype(first - x.begin()) - 1);
+    const qsizetype end = qMin(count, qsizetype(last - x.begin()) + 1);
+    return qMakePair(begin, end);
 }
 
-void FluentGraphCardWidget::addDataSeries(const QString &name, const QList<QPointF> &points)
+void FluentGraphCardWidget::seriesExtents(int series, bool visibleOnly,
+                                          double *minX, double *maxX, double *minY, double *maxY)
 {
-    m_seriesData[name] = points;
-    if (!m_seriesNames.contains(name)) {
-        m_seriesNames << name;
+    const FluentSpan<double> x = m_seriesData->xValues(series);
+    const FluentSpan<double> y = m_seriesData->yValues(series);
+
+    // Long ordered series take their extents from the pyramid without a scan
+    auto pyramid = m_lodPyramids.find(series);
+    if (pyramid != m_lodPyramids.end() && pyramid->size() == y.size() && pyramid->isSorted()) {
+        const QPair<qsizetype, qsizetype> range = visibleOnly ? visibleIndexRange(series)
+                                                              : qMakePair(qsizetype(0), y.size());
+        double low = 0.0;
+        double high = 0.0;
+        if (range.second > range.first && pyramid->yRange(y, range.first, range.second, &low, &high)) {
+            *minX = qMin(*minX, x[range.first]);
+            *maxX = qMax(*maxX, x[range.second - 1]);
+            *minY = qMin(*minY, low);
+            *maxY = qMax(*maxY, high);
+        }
+        return;
     }
-}
 
-void FluentGraphCardWidget::clearData()
-{
-    m_seriesData.clear();
-    m_categories.clear();
-    m_seriesNames.clear();
+    const FluentSeriesKernels::Extents extents =
+        visibleOnly ? FluentSeriesKernels::extents(x.data(), y.data(), y.size(), m_viewMinX, m_viewMaxX)
+                    : FluentSeriesKernels::extents(x.data(), y.data(), y.size());
+    if (extents.isValid()) {
+        *minX = qMin(*minX, extents.minX);
+        *maxX = qMax(*maxX, extents.maxX);
+        *minY = qMin(*minY, extents.minY);
+        *maxY = qMax(*maxY, extents.maxY);
+    }
 }
 
-void FluentGraphCardWidget::refreshChart()
+bool FluentGraphCardWidget::isZoomable() const
 {
-    updateChart();
+    return (m_graphType == LineChart || m_graphType == ScatterChart || m_graphType == AreaChart)
+           && !m_seriesData->isEmpty();
 }
 
-// Data Model Support Implementation
-void FluentGraphCardWidget::setDataModel(QAbstractItemModel *model)
+void FluentGraphCardWidget::zoomToRange(double minX, double maxX)
 {
-    if (m_dataModel) {
-        disconnect(m_dataModel, nullptr, this, nullptr);
+    if (!isZoomable() || !std::isfinite(minX) || !std::isfinite(maxX) || minX >= maxX) return;
+
+    double dataMinX = std::numeric_limits<double>::max();
+    double dataMaxX = std::numeric_limits<double>::lowest();
+    double dataMinY = std::numeric_limits<double>::max();
+    double dataMaxY = std::numeric_limits<double>::lowest();
+    for (int id = 0; id < m_seriesData->seriesCount(); ++id) {
+        seriesExtents(id, false, &dataMinX, &dataMaxX, &dataMinY, &dataMaxY);
     }
+    if (dataMinX >= dataMaxX) return;
 
-    m_dataModel = model;
-
-    if (m_dataModel) {
-        connect(m_dataModel, &QAbstractItemModel::dataChanged, this, &FluentGraphCardWidget::onModelDataChanged);
-        connect(m_dataModel, &QAbstractItemModel::modelReset, this, &FluentGraphCardWidget::onModelReset);
-        connect(m_dataModel, &QAbstractItemModel::rowsInserted, this, &FluentGraphCardWidget::onModelDataChanged);
-        connect(m_dataModel, &QAbstractItemModel::rowsRemoved, this, &FluentGraphCardWidget::onModelDataChanged);
+    // Zooming out past the data simply shows everything again
+    const double span = maxX - minX;
+    if (span >= dataMaxX - dataMinX) {
+        resetZoom();
+        return;
+    }
 
-        loadDataFromModel();
-    } else {
-        loadSampleData();
+    // Keep the view inside the data; stop zooming in beyond sensible precision
+    if (span < (dataMaxX - dataMinX) * 1e-9) return;
+    if (minX < dataMinX) {
+        maxX += dataMinX - minX;
+        minX = dataMinX;
+    } else if (maxX > dataMaxX) {
+        minX -= maxX - dataMaxX;
+        maxX = dataMaxX;
     }
-}
 
-QAbstractItemModel *FluentGraphCardWidget::dataModel() const
-{
-    return m_dataModel;
+    m_viewportZoomed = true;
+    m_viewMinX = minX;
+    m_viewMaxX = maxX;
+    scheduleRefresh(DirtyData);
 }
 
-void FluentGraphCardWidget::setXColumn(int column)
+void FluentGraphCardWidget::resetZoom()
 {
-    m_xColumn = column;
-    if (m_dataModel) {
-        loadDataFromModel();
-    }
-}
+    if (!m_viewportZoomed) return;
 
-void FluentGraphCardWidget::setYColumns(const QList<int> &columns)
-{
-    m_yColumns = columns;
-    if (m_dataModel) {
-        loadDataFromModel();
-    }
+    m_viewportZoomed = false;
+    scheduleRefresh(DirtyData);
 }
 
-void FluentGraphCardWidget::setSeriesNamesColumn(int column)
+bool FluentGraphCardWidget::isZoomed() const
 {
-    m_seriesNamesColumn = column;
-    if (m_dataModel) {
-        loadDataFromModel();
-    }
+    return m_viewportZoomed;
 }
 
-void FluentGraphCardWidget::loadDataFromModel()
+bool FluentGraphCardWidget::eventFilter(QObject *watched, QEvent *event)
 {
-    if (!m_dataModel) {
-        loadSampleData();
-        return;
+    QWidget *plot = plotWidget();
+    if (!plot || watched != plot) {
+        return QWidget::eventFilter(watched, event);
     }
 
-    clearData();
+    // The plot is painted from its cache; only a render into the cache is
+    // timed for the quality governor, blits cost next to nothing
+    if (event->type() == QEvent::Paint && !m_paintingPlot) {
+        QElapsedTimer timer;
+        timer.start();
+        const bool rendered = renderPlotCache(plot);
 
-    int rowCount = m_dataModel->rowCount();
-    if (rowCount == 0 || m_yColumns.isEmpty()) {
-        loadSampleData();
-        return;
-    }
+        QPainter painter(plot);
+        painter.drawPixmap(QPoint(0, 0), m_plotCache);
+        painter.end();
 
-    // Load categories from X column
-    for (int row = 0; row < rowCount; ++row) {
-        QModelIndex xIndex = m_dataModel->index(row, m_xColumn);
-        QString category = m_dataModel->data(xIndex).toString();
-        if (!category.isEmpty()) {
-            m_categories.append(category);
+        if (rendered) {
+            recordFrameTime(m_pendingUpdateNsecs + timer.nsecsElapsed());
+            m_pendingUpdateNsecs = 0;
         }
+        return true;
     }
 
-    // Load data series from Y columns
-    for (int i = 0; i < m_yColumns.size(); ++i) {
-        int yColumn = m_yColumns[i];
-        QString seriesName;
+    // Decimation follows the plot width once the view has its real geometry;
+    // every point moves on screen, so the hit-test index is stale
+    if (event->type() == QEvent::Resize) {
+        invalidateHitTestIndex();
+        invalidatePlotCache();
+        if (m_decimationMode != NoDecimation) {
+            QTimer::singleShot(0, this, &FluentGraphCardWidget::updateDecimation);
+        }
+    }
 
-        // Get series name from header or dedicated column
-        if (m_seriesNamesColumn >= 0 && i < m_dataModel->rowCount()) {
-            QModelIndex nameIndex = m_dataModel->index(i, m_seriesNamesColumn);
-            seriesName = m_dataModel->data(nameIndex).toString();
+    // Raster pie slices are hit tested here, Qt Charts slices report their
+    // own clicks; a double-click on either goes back up a drill level
+    if (m_graphType == PieChart) {
+        if (event->type() == QEvent::MouseButtonDblClick && !m_pieDrillStack.isEmpty()) {
+            drillUp();
+            return true;
+        }
+        FluentGraphRasterView *rasterView = qobject_cast<FluentGraphRasterView*>(plot);
+        if (rasterView && event->type() == QEvent::MouseButtonPress
+            && static_cast<QMouseEvent*>(event)->button() == Qt::LeftButton) {
+            const QPointF pos = static_cast<QMouseEvent*>(event)->pos();
+            pieSliceClicked(FluentGraphRenderer::pieSliceAt(pos, rasterView->plotArea(), rasterView->scene()));
         }
+    }
 
-        if (seriesName.isEmpty()) {
-            seriesName = m_dataModel->headerData(yColumn, Qt::Horizontal).toString();
-            if (seriesName.isEmpty()) {
-                seriesName = QString("Series %1").arg(i + 1);
+    if (!isZoomable()) {
+        return QWidget::eventFilter(watched, event);
+    }
+
+    switch (event->type()) {
+        case QEvent::Wheel: {
+            QWheelEvent *wheelEvent = static_cast<QWheelEvent*>(event);
+            const int delta = wheelEvent->angleDelta().y();
+            if (delta == 0) break;
+
+            // Zoom about the value under the cursor, 20% per wheel notch
+            double anchorX = 0.0;
+            if (!mapToDataX(wheelEvent->position().toPoint(), &anchorX)) break;
+
+            double minX = m_viewMinX;
+            double maxX = m_viewMaxX;
+            if (!m_viewportZoomed) {
+                double minY = 0.0;
+                double maxY = 0.0;
+                if (!axisRanges(&minX, &maxX, &minY, &maxY)) break;
             }
-        }
 
-        QList<QPointF> points;
-        for (int row = 0; row < rowCount; ++row) {
-            QModelIndex yIndex = m_dataModel->index(row, yColumn);
-            bool ok;
-            double value = m_dataModel->data(yIndex).toDouble(&ok);
-            if (ok) {
-                points.append(QPointF(row, value));
+            const double factor = std::pow(0.8, delta / 120.0);
+            zoomToRange(anchorX - (anchorX - minX) * factor, anchorX + (maxX - anchorX) * factor);
+            return true;
+        }
+        case QEvent::MouseButtonPress: {
+            QMouseEvent *mouseEvent = static_cast<QMouseEvent*>(event);
+            if (mouseEvent->button() == Qt::LeftButton && m_viewportZoomed) {
+                m_panning = true;
+                m_panStartPos = mouseEvent->pos();
+                m_panStartMinX = m_viewMinX;
+                m_panStartMaxX = m_viewMaxX;
+                plot->setCursor(Qt::ClosedHandCursor);
             }
+            break;
         }
-
-        if (!points.isEmpty()) {
-            m_seriesData[seriesName] = points;
-            m_seriesNames.append(seriesName);
+        case QEvent::MouseMove: {
+            QMouseEvent *mouseEvent = static_cast<QMouseEvent*>(event);
+            const double plotWidth = plotAreaRect().width();
+            if (m_panning && plotWidth > 0) {
+                // Dragging right reveals earlier values
+                const int dx = mouseEvent->pos().x() - m_panStartPos.x();
+                const double shift = -dx * (m_panStartMaxX - m_panStartMinX) / plotWidth;
+                zoomToRange(m_panStartMinX + shift, m_panStartMaxX + shift);
+                return true;
+            }
+            break;
         }
+        case QEvent::MouseButtonRelease:
+            if (m_panning) {
+                m_panning = false;
+                plot->unsetCursor();
+            }
+            break;
+        case QEvent::MouseButtonDblClick:
+            resetZoom();
+            return true;
+        default:
+            break;
     }
 
-    refreshChart();
+    return QWidget::eventFilter(watched, event);
 }
 
-void FluentGraphCardWidget::onModelDataChanged()
+QWidget *FluentGraphCardWidget::plotWidget() const
 {
-    loadDataFromModel();
+    if (FluentGraphRasterView *rasterView = qobject_cast<FluentGraphRasterView*>(m_chartView)) {
+        return rasterView;
+    }
+#ifndef FLUENTWIDGET_NO_QTCHARTS
+    if (QChartView *chartView = qobject_cast<QChartView*>(m_chartView)) {
+        return chartView->viewport();
+    }
+#endif
+    return nullptr;
 }
 
-void FluentGraphCardWidget::onModelReset()
+QRectF FluentGraphCardWidget::plotAreaRect() const
+{
+    if (FluentGraphRasterView *rasterView = qobject_cast<FluentGraphRasterView*>(m_chartView)) {
+        return rasterView->plotArea();
+    }
+#ifndef FLUENTWIDGET_NO_QTCHARTS
+    if (QChartView *chartView = qobject_cast<QChartView*>(m_chartView)) {
+        if (QChart *chart = chartView->chart()) {
+            return chart->plotArea();
+        }
+    }
+#endif
+    return QRectF();
+}
+
+bool FluentGraphCardWidget::mapToDataX(const QPoint &pos, double *x) const
 {
-    loadDataFromModel();
+    if (FluentGraphRasterView *rasterView = qobject_cast<FluentGraphRasterView*>(m_chartView)) {
+        *x = FluentGraphRenderer::mapToValue(pos, rasterView->plotArea(), rasterView->scene()).x();
+        return true;
+    }
+#ifndef FLUENTWIDGET_NO_QTCHARTS
+    if (QChartView *chartView = qobject_cast<QChartView*>(m_chartView)) {
+        if (QChart *chart = chartView->chart()) {
+            *x = chart->mapToValue(chart->mapFromScene(chartView->mapToScene(pos))).x();
+            return true;
+        }
+    }
+#endif
+    return false;
 }
 
 // Interactive Features Implementation
-QPair<QString, int> FluentGraphCardWidget::findDataPointAt(const QPoint &pos) const
+QPair<QString, int> FluentGraphCardWidget::findDataPointAt(const QPoint &pos)
 {
-    QChartView *chartView = qobject_cast<QChartView*>(m_chartView);
-    if (!chartView || m_seriesData.isEmpty()) {
+    QWidget *plot = plotWidget();
+    if (!plot || m_seriesData->isEmpty()) {
         return QPair<QString, int>(QString(), -1);
     }
 
-    QChart *chart = chartView->chart();
-    if (!chart) return QPair<QString, int>(QString(), -1);
-
-    // Convert widget coordinates to chart coordinates
-    QPointF chartPos = chart->mapFromScene(chartView->mapToScene(pos));
-
-    // Check each series for nearby points
-    for (auto it = m_seriesData.constBegin(); it != m_seriesData.constEnd(); ++it) {
-        const QString &seriesName = it.key();
-        const QList<QPointF> &points = it.value();
-
-        // Find corresponding series in chart
-        QList<QAbstractSeries*> allSeries = chart->series();
-        for (QAbstractSeries *abstractSeries : allSeries) {
-            if (abstractSeries->name() == seriesName) {
-                // Check if this is a line series for point detection
-                if (QLineSeries *lineSeries = qobject_cast<QLineSeries*>(abstractSeries)) {
-                    QList<QPointF> chartPoints = lineSeries->points();
-                    for (int i = 0; i < chartPoints.size(); ++i) {
-                        QPointF scenePoint = chart->mapToPosition(chartPoints[i], abstractSeries);
-                        if (isPointNearMouse(scenePoint, pos, 10)) {
-                            return QPair<QString, int>(seriesName, i);
-                        }
-                    }
-                }
-                // Check scatter series
-                else if (QScatterSeries *scatterSeries = qobject_cast<QScatterSeries*>(abstractSeries)) {
-                    QList<QPointF> chartPoints = scatterSeries->points();
-                    for (int i = 0; i < chartPoints.size(); ++i) {
-                        QPointF scenePoint = chart->mapToPosition(chartPoints[i], abstractSeries);
-                        if (isPointNearMouse(scenePoint, pos, 10)) {
-                            return QPair<QString, int>(seriesName, i);
-                        }
-                    }
-                }
-                break;
-            }
+    if (!m_hitTestIndexValid) {
+        rebuildHitTestIndex();
+    }
+
+    // The index holds plot positions in the coordinates of the rendering
+    // surface: raster view pixels or chart item coordinates
+    QPointF plotPos = plot->mapFrom(this, pos);
+#ifndef FLUENTWIDGET_NO_QTCHARTS
+    if (QChartView *chartView = qobject_cast<QChartView*>(m_chartView)) {
+        if (QChart *chart = chartView->chart()) {
+            plotPos = chart->mapFromScene(chartView->mapToScene(plotPos.toPoint()));
+        }
+    }
+#endif
+
+    const QPair<int, int> hit = m_hitTestIndex.pointAt(plotPos, 10);
+    if (hit.first < 0) {
+        return QPair<QString, int>(QString(), -1);
+    }
+
+    return QPair<QString, int>(m_seriesData->seriesName(hit.first), rawPointIndex(hit.first, hit.second));
+}
+
+void FluentGraphCardWidget::invalidateHitTestIndex()
+{
+    m_hitTestIndexValid = false;
+}
+
+void FluentGraphCardWidget::rebuildHitTestIndex()
+{
+    m_hitTestIndex.clear();
+    m_hitTestIndexValid = true;
+
+    if (m_graphType == BarChart || m_graphType == PieChart) return;
+
+    if (FluentGraphRasterView *rasterView = qobject_cast<FluentGraphRasterView*>(m_chartView)) {
+        // Scene points are the (possibly decimated) points on screen
+        const FluentGraphScene &scene = rasterView->scene();
+        const QRectF plotArea = rasterView->plotArea();
+        const QPointF minValue(scene.minX, scene.minY);
+        const QPointF maxValue(scene.maxX, scene.maxY);
+        m_hitTestIndex.setMapping(minValue, FluentGraphRenderer::mapToPosition(minValue, plotArea, scene),
+                                  maxValue, FluentGraphRenderer::mapToPosition(maxValue, plotArea, scene),
+                                  plotArea);
+
+        for (const FluentGraphScene::Series &series : scene.series) {
+            m_hitTestIndex.addSeries(m_seriesData->seriesId(series.name), series.points,
+                                     scene.kind == FluentGraphScene::Scatter);
         }
+        return;
     }
 
-    return QPair<QString, int>(QString(), -1);
+#ifndef FLUENTWIDGET_NO_QTCHARTS
+    QChartView *chartView = qobject_cast<QChartView*>(m_chartView);
+    QChart *chart = chartView ? chartView->chart() : nullptr;
+    if (!chart) return;
+
+    double minX = 0.0;
+    double maxX = 0.0;
+    double minY = 0.0;
+    double maxY = 0.0;
+    if (!axisRanges(&minX, &maxX, &minY, &maxY)) return;
+
+    bool mapped = false;
+    for (QAbstractSeries *abstractSeries : chart->series()) {
+        // Line and scatter series hold the decimated points of their series
+        QXYSeries *series = qobject_cast<QLineSeries*>(abstractSeries);
+        const bool scatter = !series;
+        if (scatter) {
+            series = qobject_cast<QScatterSeries*>(abstractSeries);
+        }
+        const int id = m_seriesData->seriesId(abstractSeries->name());
+        if (!series || id < 0) continue;
+
+        // Every series shares the card's axes, so one mapping serves all
+        if (!mapped) {
+            const QPointF minValue(minX, minY);
+            const QPointF maxValue(maxX, maxY);
+            m_hitTestIndex.setMapping(minValue, chart->mapToPosition(minValue, series),
+                                      maxValue, chart->mapToPosition(maxValue, series),
+                                      chart->plotArea());
+            mapped = true;
+        }
+
+        m_hitTestIndex.addSeries(id, series->points(), scatter);
+    }
+#endif
 }
 
 void FluentGraphCardWidget::showDataPointTooltip(const QPoint &pos, const QString &series, int pointIndex, double value)
 {
     QString tooltipText;
+    QString label;
+
+    if (usesTimeAxis()) {
+        const int id = m_seriesData->seriesId(series);
+        if (id >= 0 && pointIndex >= 0 && pointIndex < m_seriesData->size(id)) {
+            label = timeLabel(m_seriesData->xValues(id)[pointIndex]);
+        }
+    } else if (pointIndex >= 0 && pointIndex < m_categories->size()) {
+        label = m_categories->at(pointIndex);
+    }
 
-    if (pointIndex >= 0 && pointIndex < m_categories.size()) {
+    if (!label.isEmpty()) {
         tooltipText = QString("%1\n%2: %3")
-                     .arg(m_categories[pointIndex])
+                     .arg(label)
                      .arg(series)
                      .arg(QString::number(value, 'f', 2));
     } else {
@@ -891,8 +3626,9 @@ void FluentGraphCardWidget::mousePressEvent(QMouseEvent *event)
             const QString &seriesName = hitResult.first;
             int pointIndex = hitResult.second;
 
-            if (m_seriesData.contains(seriesName) && pointIndex < m_seriesData[seriesName].size()) {
-                double value = m_seriesData[seriesName][pointIndex].y();
+            const int id = m_seriesData->seriesId(seriesName);
+            if (id >= 0 && pointIndex < m_seriesData->size(id)) {
+                double value = m_seriesData->yValues(id)[pointIndex];
                 emit dataPointClicked(seriesName, pointIndex, value);
             }
         }
@@ -918,8 +3654,9 @@ void FluentGraphCardWidget::mouseMoveEvent(QMouseEvent *event)
             m_hoveredSeries = seriesName;
             m_hoveredPointIndex = pointIndex;
 
-            if (m_seriesData.contains(seriesName) && pointIndex < m_seriesData[seriesName].size()) {
-                double value = m_seriesData[seriesName][pointIndex].y();
+            const int id = m_seriesData->seriesId(seriesName);
+            if (id >= 0 && pointIndex < m_seriesData->size(id)) {
+                double value = m_seriesData->yValues(id)[pointIndex];
 
                 // Show tooltip
                 showDataPointTooltip(event->pos(), seriesName, pointIndex, value);
@@ -959,16 +3696,27 @@ void FluentGraphCardWidget::onHoverAnimationFinished()
 
 void FluentGraphCardWidget::paintEvent(QPaintEvent *event)
 {
+    FLUENT_PERF_SCOPE(Paint);
     QStyleOption opt;
     opt.initFrom(this);
     QPainter p(this);
     style()->drawPrimitive(QStyle::PE_Widget, &opt, &p, this);
 }
 
+void FluentGraphCardWidget::showEvent(QShowEvent *event)
+{
+    ensureChart();
+    QWidget::showEvent(event);
+}
+
 void FluentGraphCardWidget::resizeEvent(QResizeEvent *event)
 {
     QWidget::resizeEvent(event);
-    // Chart view will automatically resize with the widget
+    // Chart view will automatically resize with the widget; the plot area is
+    // only laid out afterwards, so decimation is re-checked once that settled
+    if (m_decimationMode != NoDecimation) {
+        QTimer::singleShot(0, this, &FluentGraphCardWidget::updateDecimation);
+    }
 }
 
 QSize FluentGraphCardWidget::sizeHint() const
@@ -980,23 +3728,3 @@ QSize FluentGraphCardWidget::minimumSizeHint() const
 {
     return QSize(300, 250);
 }
-
-void FluentGraphCardWidget::safelyRemoveAllSeries()
-{
-    QChartView *chartView = qobject_cast<QChartView*>(m_chartView);
-    if (!chartView) return;
-
-    QChart *chart = chartView->chart();
-    if (!chart) return;
-
-    // Get all series before removing them
-    QList<QAbstractSeries*> seriesList = chart->series();
-
-    // Remove each series individually to avoid issues
-    for (QAbstractSeries *series : seriesList) {
-        if (series) {
-            chart->removeSeries(series);
-            series->deleteLater(); // Schedule for deletion
-        }
-    }
-}
\ No newline at end of file
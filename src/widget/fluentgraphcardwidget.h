@@ -14,18 +14,45 @@
 #include <QAbstractItemModel>
 #include <QToolTip>
 #include <QMouseEvent>
+#include <QHash>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QFutureWatcher>
+#include <QFileSystemWatcher>
+#include <QVariant>
+#include <QPointer>
+#include <QPixmap>
+#include <QDateTime>
+
+#include "fluentlodpyramid.h"
+#include "fluentseriestable.h"
+#include "fluentseriesstore.h"
+#include "fluentseriesoverlay.h"
+#include "fluentgraphrenderer.h"
+#include "fluenthittestindex.h"
+#include "fluentreorderbuffer.h"
+#include "fluenttopnselector.h"
+
+class FluentMappedSeriesFile;
+struct FluentCsvColumns;
 
 // Forward declarations for Qt Charts
 QT_BEGIN_NAMESPACE
 class QChart;
 class QChartView;
 class QAbstractSeries;
+class QAbstractAxis;
+class QPieSlice;
 QT_END_NAMESPACE
 
 class FluentGraphCardWidget : public QWidget
 {
     Q_OBJECT
     Q_ENUMS(GraphType)
+    Q_ENUMS(DecimationMode)
+    Q_ENUMS(RenderBackend)
+    Q_ENUMS(RenderQuality)
+    Q_FLAGS(Overlays)
     Q_PROPERTY(QString title READ title WRITE setTitle)
     Q_PROPERTY(QString subtitle READ subtitle WRITE setSubtitle)
     Q_PROPERTY(GraphType graphType READ graphType WRITE setGraphType)
@@ -35,6 +62,25 @@ class FluentGraphCardWidget : public QWidget
     Q_PROPERTY(QColor accentColor READ accentColor WRITE setAccentColor)
     Q_PROPERTY(QString dataSource READ dataSource WRITE setDataSource)
     Q_PROPERTY(bool animated READ isAnimated WRITE setAnimated)
+    Q_PROPERTY(int retentionCount READ retentionCount WRITE setRetentionCount)
+    Q_PROPERTY(double retentionSpan READ retentionSpan WRITE setRetentionSpan)
+    Q_PROPERTY(DecimationMode decimationMode READ decimationMode WRITE setDecimationMode)
+    Q_PROPERTY(RenderBackend renderBackend READ renderBackend WRITE setRenderBackend)
+    Q_PROPERTY(int maxRefreshRate READ maxRefreshRate WRITE setMaxRefreshRate)
+    Q_PROPERTY(bool adaptiveQuality READ isAdaptiveQuality WRITE setAdaptiveQuality)
+    Q_PROPERTY(int frameBudget READ frameBudget WRITE setFrameBudget)
+    Q_PROPERTY(RenderQuality renderQuality READ renderQuality NOTIFY renderQualityChanged)
+    Q_PROPERTY(Overlays overlays READ overlays WRITE setOverlays)
+    Q_PROPERTY(QString overlaySeries READ overlaySeries WRITE setOverlaySeries)
+    Q_PROPERTY(int overlayWindow READ overlayWindow WRITE setOverlayWindow)
+    Q_PROPERTY(double ewmaAlpha READ ewmaAlpha WRITE setEwmaAlpha)
+    Q_PROPERTY(double sigmaBandWidth READ sigmaBandWidth WRITE setSigmaBandWidth)
+    Q_PROPERTY(bool timeSeries READ isTimeSeries WRITE setTimeSeries)
+    Q_PROPERTY(QString timeFormat READ timeFormat WRITE setTimeFormat)
+    Q_PROPERTY(int reorderWindow READ reorderWindow WRITE setReorderWindow)
+    Q_PROPERTY(int maxSlices READ maxSlices WRITE setMaxSlices)
+    Q_PROPERTY(int maxModelUpdateRate READ maxModelUpdateRate WRITE setMaxModelUpdateRate)
+    Q_PROPERTY(bool asyncModelLoading READ isAsyncModelLoading WRITE setAsyncModelLoading)
 
 public:
     enum GraphType {
@@ -45,6 +91,35 @@ public:
         AreaChart
     };
 
+    enum DecimationMode {
+        NoDecimation,
+        LTTBDecimation,
+        MinMaxEnvelopeDecimation
+    };
+
+    enum RenderBackend {
+        QtChartsBackend,
+        RasterBackend
+    };
+
+    // Each level keeps the reductions of the ones before it
+    enum RenderQuality {
+        FullQuality,        // as configured
+        StaticQuality,      // no series animations
+        AliasedQuality,     // no antialiasing
+        CoarseQuality       // one decimation bucket per 4 pixels instead of 1
+    };
+
+    // Statistics drawn over line, scatter and area charts
+    enum Overlay {
+        NoOverlay = 0x0,
+        MovingAverageOverlay = 0x1,     // mean of the last overlayWindow points
+        EwmaOverlay = 0x2,              // exponentially weighted, smoothing ewmaAlpha
+        MinMaxBandOverlay = 0x4,        // min and max of the last overlayWindow points
+        SigmaBandOverlay = 0x8          // mean +/- sigmaBandWidth standard deviations
+    };
+    Q_DECLARE_FLAGS(Overlays, Overlay)
+
     explicit FluentGraphCardWidget(QWidget *parent = nullptr);
     virtual ~FluentGraphCardWidget();
 
@@ -70,21 +145,154 @@ public:
     QColor accentColor() const;
     void setAccentColor(const QColor &color);
 
+    // A local file path or file:// URI loads the file; mapped series files
+    // (see FluentMappedSeriesFile) are read in place and followed as they grow,
+    // CSV files (see FluentCsvReader) are parsed on a worker thread
     QString dataSource() const;
     void setDataSource(const QString &source);
+    bool isLoadingFile() const;
 
     bool isAnimated() const;
     void setAnimated(bool animated);
 
+    // Streaming retention (0 = unlimited). It is kept by the series store,
+    // which owns the data: on a shared store these read and set the one
+    // retention of every card showing it
+    int retentionCount() const;
+    void setRetentionCount(int count);
+
+    double retentionSpan() const;
+    void setRetentionSpan(double span);
+
+    // Decimation of line, area and scatter series to the plot width
+    DecimationMode decimationMode() const;
+    void setDecimationMode(DecimationMode mode);
+
+    // Qt Charts scene graph or direct QPainter drawing; builds without Qt
+    // Charts always use the raster backend
+    RenderBackend renderBackend() const;
+    void setRenderBackend(RenderBackend backend);
+
+    // Setters and data changes mark the chart dirty; it is rebuilt at most
+    // this many times per second (0 = once per event loop turn)
+    int maxRefreshRate() const;
+    void setMaxRefreshRate(int rate);
+
+    // With adaptive quality the card times its chart updates and paints;
+    // quality drops a level while frames exceed the budget (milliseconds)
+    // and comes back a level at a time once they fit in half of it
+    bool isAdaptiveQuality() const;
+    void setAdaptiveQuality(bool adaptive);
+
+    int frameBudget() const;
+    void setFrameBudget(int msecs);
+
+    RenderQuality renderQuality() const;
+
+    // Overlays follow one series (the first when overlaySeries is empty) and
+    // take O(1) work per appended point; they exist only while enabled
+    Overlays overlays() const;
+    void setOverlays(Overlays overlays);
+
+    QString overlaySeries() const;
+    void setOverlaySeries(const QString &series);
+
+    int overlayWindow() const;
+    void setOverlayWindow(int points);
+
+    double ewmaAlpha() const;
+    void setEwmaAlpha(double alpha);
+
+    double sigmaBandWidth() const;
+    void setSigmaBandWidth(double deviations);
+
+    // Time series: x values are milliseconds since the epoch, kept sorted and
+    // labelled with timeFormat on a date/time axis (line, scatter and area
+    // charts). They are stored exactly, as any time within 2^53 ms of the
+    // epoch is a whole double. The model X column is read as timestamps
+    // instead of categories; retentionSpan is in milliseconds
+    bool isTimeSeries() const;
+    void setTimeSeries(bool timeSeries);
+
+    QString timeFormat() const;
+    void setTimeFormat(const QString &format);
+
+    // Samples from appendSample() are held this many milliseconds behind the
+    // newest one, so slightly out-of-order arrivals still go in order
+    int reorderWindow() const;
+    void setReorderWindow(int msecs);
+
+    // Pie charts show the maxSlices largest values (0 = every value) and
+    // fold the others into a last "Other" slice. Clicking it drills into the
+    // folded categories, which get the same treatment; double-clicking the
+    // pie goes back up a level
+    int maxSlices() const;
+    void setMaxSlices(int slices);
+
+    QStringList foldedCategories() const;
+    int pieDrillLevel() const;
+    void drillIntoOther();
+    void drillUp();
+
     QSize sizeHint() const override;
     QSize minimumSizeHint() const override;
 
     // Data management methods
     void addDataPoint(const QString &category, double value);
+
+    // addDataPoint() for count pairs of categories[i] and values[i] at once
+    void addDataPoints(const QString *categories, const double *values, qsizetype count);
+    void addDataPoints(const QStringList &categories, const QList<double> &values);
     void addDataSeries(const QString &name, const QList<QPointF> &points);
     void clearData();
+
+    // Replaces the data with sample series; does nothing on a shared store
     void loadSampleData();
 
+    // Columnar read access to the stored series, in insertion order
+    const FluentSeriesTable &seriesData() const;
+    QStringList categories() const;
+
+    // Cards given the same store show a single copy of its data, and one
+    // write reaches all of them. Data sources, retention and the data methods
+    // below write to the store of the card they are used on. nullptr goes
+    // back to the card's own store.
+    FluentSeriesStore *seriesStore() const;
+    void setSeriesStore(FluentSeriesStore *store);
+
+    // What a card draws besides its data, for rendering without a widget
+    struct RenderConfig {
+        GraphType graphType = LineChart;
+        bool darkMode = false;
+        QColor accentColor = QColor(0, 120, 215);
+        bool showLegend = true;
+        bool showGrid = true;
+        DecimationMode decimationMode = LTTBDecimation;
+        bool timeSeries = false;
+        QString timeFormat = QStringLiteral("hh:mm:ss");
+        int maxSlices = 0;
+    };
+    RenderConfig renderConfig() const;
+
+    // Draws the series as a raster backend card would into an image of size
+    // device-independent pixels. Touches no widget or GUI thread state, so
+    // export pages can be rendered on worker threads in parallel
+    static QImage renderImage(const RenderConfig &config, const FluentSeriesTable &series,
+                              const QStringList &categories, const QSize &size,
+                              qreal devicePixelRatio = 1.0);
+
+    // Streaming data methods
+    void appendPoint(const QString &series, const QPointF &point);
+    void appendPoints(const QString &series, const QPointF *points, qsizetype count);
+    void appendPoints(const QString &series, const QList<QPointF> &points);
+
+    // Timestamped samples, committed through the reorder buffer of their
+    // series. Samples older than what a series already holds are dropped
+    // and counted
+    void appendSample(const QString &series, qint64 msecsSinceEpoch, double value);
+    void appendSample(const QString &series, const QDateTime &time, double value);
+    qint64 lateSampleCount() const;
+
     // Model data methods
     void setDataModel(QAbstractItemModel *model);
     QAbstractItemModel *dataModel() const;
@@ -93,8 +301,29 @@ public:
     void setSeriesNamesColumn(int column);
     void loadDataFromModel();
 
+    // setDataModel() and the column setters only schedule a load, so setting
+    // up a model costs one load; loadDataFromModel() loads right away
+
+    // Model changes are applied at most this many times per second
+    // (0 = once per event loop turn)
+    int maxModelUpdateRate() const;
+    void setMaxModelUpdateRate(int rate);
+
+    // Convert model cells on a worker thread; the chart keeps showing the
+    // previous data until the result is swapped in
+    bool isAsyncModelLoading() const;
+    void setAsyncModelLoading(bool async);
+    bool isLoadingModel() const;
+
+    // Zoom and pan (line, area and scatter charts)
+    void zoomToRange(double minX, double maxX);
+    bool isZoomed() const;
+
 public slots:
     void refreshChart();
+    void resetZoom();
+    void cancelLoading();
+    void flushSamples();
 
 signals:
     void chartClicked(const QString &series, const QPointF &point);
@@ -102,38 +331,190 @@ signals:
     void dataPointHovered(const QString &series, int pointIndex, double value);
     void chartHoverLeft();
     void legendClicked(const QString &series);
+    void otherSliceClicked(const QStringList &categories);
+    void dataLoaded(int rowCount, qint64 snapshotMsecs, qint64 conversionMsecs);
+    void loadProgress(int percent);
+    void renderQualityChanged(FluentGraphCardWidget::RenderQuality quality);
 
 protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
     void enterEvent(QEnterEvent *event) override;
     void leaveEvent(QEvent *event) override;
     void paintEvent(QPaintEvent *event) override;
+    void showEvent(QShowEvent *event) override;
     void resizeEvent(QResizeEvent *event) override;
     void mousePressEvent(QMouseEvent *event) override;
     void mouseMoveEvent(QMouseEvent *event) override;
 
 private slots:
     void onHoverAnimationFinished();
-    void onModelDataChanged();
+    void onModelDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight);
+    void onModelRowsInserted(const QModelIndex &parent, int first, int last);
+    void onModelRowsChanged();
     void onModelReset();
+    void flushModelChanges();
+    void onModelLoadFinished();
+    void onDataSourceFileChanged(const QString &path);
+    void onCsvLoadFinished();
+    void updateDecimation();
+    void flushRefresh();
+    void invalidateHitTestIndex();
+    void invalidatePlotCache();
+    void onSeriesAppended(int id, qsizetype appended, qsizetype removed);
+    void onSeriesChanged(int id);
+    void onSeriesDataReset();
+    void onSeriesStoreDestroyed();
+#ifndef FLUENTWIDGET_NO_QTCHARTS
+    void onPieSliceClicked(QPieSlice *slice);
+#endif
 
 private:
     void setupUI();
     void setupChart();
+    void ensureChart();
     void setupShadowEffect();
     void setupHoverAnimation();
     void updateTheme();
     void updateStyles();
     void updateChart();
+    FluentGraphScene buildRasterScene();
+    bool axisRanges(double *minX, double *maxX, double *minY, double *maxY);
+    static void setSceneCategories(FluentGraphScene *scene, const QStringList &categories);
+    void applyChartTheme();
+    void applyChartStyle();
+
+    // Deferred refresh: what changed since the chart was last brought up to date
+    enum DirtyFlag {
+        DirtyData = 0x1,    // series, chart type, decimation or viewport
+        DirtyStyle = 0x2,   // theme, legend and colours
+        DirtyAxes = 0x4     // axis ranges and grid
+    };
+    void scheduleRefresh(int flags);
+
+    // Quality governor
+    bool animationsEnabled() const;
+    void recordFrameTime(qint64 nsecs);
+    void setRenderQuality(RenderQuality quality);
+
+    // Plot render cache
+    bool renderPlotCache(QWidget *plot);
+
+    // Statistic overlays
+    bool showsOverlays() const;
+    void updateOverlay();
+    QList<FluentSeriesOverlay::Statistic> overlayStatistics() const;
+    QString overlayName(FluentSeriesOverlay::Statistic statistic) const;
+    QColor overlayColor(FluentSeriesOverlay::Statistic statistic) const;
+    QList<QPointF> overlayPoints(FluentSeriesOverlay::Statistic statistic) const;
+
+    // Time series
+    bool usesTimeAxis() const;
+    QString timeLabel(double x) const;
+    void commitSamples(const QString &series, const QList<FluentReorderBuffer::Sample> &samples);
+
+    // Pie slices: labels and values to draw, the category behind each slice
+    // (-1 for "Other") and the categories "Other" folds, in order
+    struct PieSlices {
+        QStringList labels;
+        QList<qreal> values;
+        QList<qsizetype> categories;
+        QList<qsizetype> folded;
+    };
+    static PieSlices pieSlices(FluentTopNSelector *selector, const FluentSpan<double> &values,
+                               const QStringList &categories, const QList<qsizetype> &scope,
+                               int maxSlices);
+    void updatePieSlices();
+    void pieSliceClicked(int slice);
+#ifndef FLUENTWIDGET_NO_QTCHARTS
     void createLineChart();
     void createBarChart();
     void createPieChart();
     void createScatterChart();
     void createAreaChart();
-    void applyChartTheme();
-    void safelyRemoveAllSeries();
+
+    // In-place reconciliation helpers
+    void removeIncompatibleSeries();
+    void removeSeries(const QList<QAbstractSeries*> &seriesList);
+    QAbstractAxis *ensureAxis(Qt::Orientation orientation, bool category);
+    void attachAxes(QAbstractSeries *series, QAbstractAxis *axisX, QAbstractAxis *axisY);
+    void updateAxes();
+    void updateOverlaySeries();
+    bool appendToOverlaySeries(qsizetype appended, qsizetype removed);
+    static bool isOverlaySeries(const QAbstractSeries *series);
+#endif
+
+    // Streaming helpers
+    bool appendToChartSeries(int series, qsizetype appended, qsizetype removed);
+
+    // Decimation helpers
+    int decimationBucketCount() const;
+    bool needsDecimation(qsizetype count) const;
+    QList<QPointF> decimatedPoints(int series);
+    static QList<QPointF> lttbFromEnvelope(const QList<QPointF> &envelope, qsizetype buckets,
+                                           QList<qsizetype> *rawIndices = nullptr);
+    int rawPointIndex(int series, int index) const;
+
+    // Level of detail helpers
+    FluentLodPyramid &lodPyramid(int series);
+    QPair<qsizetype, qsizetype> visibleIndexRange(int series);
+    void seriesExtents(int series, bool visibleOnly, double *minX, double *maxX, double *minY, double *maxY);
+    bool isZoomable() const;
+
+    // Plot geometry shared by both render backends
+    QWidget *plotWidget() const;
+    QRectF plotAreaRect() const;
+    bool mapToDataX(const QPoint &pos, double *x) const;
+
+    // Model loading: cells are copied on the GUI thread, converted (possibly
+    // on a worker) and swapped into the series in one go
+    struct ModelSnapshot {
+        int generation;
+        int rowCount;
+        bool timeSeries;
+        qint64 snapshotMsecs;
+        QList<QVariant> categories;
+        QStringList seriesNames;
+        QList<QList<QVariant>> columns;
+    };
+
+    struct ModelColumns {
+        int generation;
+        int rowCount;
+        qint64 snapshotMsecs;
+        qint64 conversionMsecs;
+        QStringList categories;
+        QStringList seriesNames;
+        QList<double> rows;         // shared x column of series without gaps
+        QList<QList<double>> x;     // per y column, empty when rows applies
+        QList<QList<double>> y;
+        bool rowsInOrder;           // rows holds every model row, in model order
+    };
+
+    ModelSnapshot takeModelSnapshot() const;
+    static ModelColumns convertModelSnapshot(const ModelSnapshot &snapshot);
+    static bool toModelValue(const QVariant &variant, double *value);
+    static bool toModelTime(const QVariant &variant, qint64 *msecs);
+    void applyModelColumns(const ModelColumns &columns);
+
+    // File data sources
+    static QString dataSourceFileName(const QString &source);
+    bool loadDataFromFile(const QString &fileName);
+    bool loadMappedFile(const QString &fileName);
+    void loadCsvFile(const QString &fileName);
+    void applyCsvColumns(const FluentCsvColumns &columns);
+
+    void detachDataSources();
+
+    // Model change helpers
+    void scheduleModelFlush();
+    void scheduleModelReload();
+    void clearModelChanges();
+    bool updateModelRows(int firstRow, int lastRow, int firstColumn, int lastColumn);
+    bool appendModelRows();
 
     // Interactive methods
-    QPair<QString, int> findDataPointAt(const QPoint &pos) const;
+    QPair<QString, int> findDataPointAt(const QPoint &pos);
+    void rebuildHitTestIndex();
     void showDataPointTooltip(const QPoint &pos, const QString &series, int pointIndex, double value);
     bool isPointNearMouse(const QPointF &chartPoint, const QPoint &mousePos, int tolerance = 8) const;
 
@@ -160,17 +541,69 @@ private:
     QColor m_accentColor;
     QString m_dataSource;
     bool m_animated;
-
-    // Data storage
-    QMap<QString, QList<QPointF>> m_seriesData;
-    QStringList m_categories;
-    QStringList m_seriesNames;
+    DecimationMode m_decimationMode;
+    RenderBackend m_renderBackend;
+
+    // Data storage: series columns keyed by id, plus the category labels
+    // shared by bar and pie charts. Both live in the current store, the
+    // card's own unless a shared one was set
+    FluentSeriesStore *m_localSeriesStore;
+    QPointer<FluentSeriesStore> m_seriesStore;
+    FluentSeriesTable *m_seriesData;
+    QStringList *m_categories;
+
+    // Decimation state: plot width the series were last reduced to and, per
+    // decimated series, the raw index behind every point on screen
+    int m_decimationBuckets;
+    QHash<int, QList<qsizetype>> m_rawIndices;
+
+    // Level of detail and viewport state
+    QHash<int, FluentLodPyramid> m_lodPyramids;
+    bool m_viewportZoomed;
+    double m_viewMinX;
+    double m_viewMaxX;
+    bool m_panning;
+    QPoint m_panStartPos;
+    double m_panStartMinX;
+    double m_panStartMaxX;
+
+    // Screen positions of the points on the plot, rebuilt on the first hover
+    // after a data or layout change
+    FluentHitTestIndex m_hitTestIndex;
+    bool m_hitTestIndexValid;
 
     // Data model support
     QAbstractItemModel *m_dataModel;
     int m_xColumn;
     QList<int> m_yColumns;
     int m_seriesNamesColumn;
+    QList<int> m_modelSeriesIds;   // series id per y column, -1 if it has none
+    int m_modelRowCount;           // rows read into the series, -1 if not from the model
+    bool m_modelRowsInOrder;       // model row r is point r of every gap-free series
+    bool m_asyncModelLoading;
+    int m_modelLoadGeneration;
+    QFutureWatcher<ModelColumns> *m_modelLoadWatcher;
+
+    // Pending model changes, applied together by flushModelChanges()
+    QTimer *m_modelFlushTimer;
+    QElapsedTimer m_modelFlushClock;
+    int m_maxModelUpdateRate;
+    bool m_modelReloadPending;
+    bool m_modelAppendPending;
+    int m_dirtyFirstRow;
+    int m_dirtyLastRow;
+    int m_dirtyFirstColumn;
+    int m_dirtyLastColumn;
+
+    // File data source: the mapped capture the series read from, watched
+    // so rows appended by the writer show up
+    QSharedPointer<FluentMappedSeriesFile> m_mappedSource;
+    QList<int> m_mappedSeriesIds;   // series id per mapped column, -1 if it has none
+    QFileSystemWatcher *m_dataSourceWatcher;
+
+    // CSV file being parsed on a worker thread
+    QFutureWatcher<FluentCsvColumns> *m_csvLoadWatcher;
+    QElapsedTimer m_csvLoadClock;
 
     // Animation state
     bool m_isHovered;
@@ -180,8 +613,56 @@ private:
     QString m_hoveredSeries;
     int m_hoveredPointIndex;
 
-    // Chart initialization state
+    // Chart initialization state: the chart view is built on first show
     bool m_chartInitialized;
+
+    // Pending refresh, applied together by flushRefresh()
+    QTimer *m_refreshTimer;
+    QElapsedTimer m_refreshClock;
+    int m_maxRefreshRate;
+    int m_dirtyFlags;
+
+    // Quality governor: smoothed cost of a frame against the budget
+    bool m_adaptiveQuality;
+    int m_frameBudget;
+    RenderQuality m_renderQuality;
+    double m_frameCost;             // milliseconds, chart updates plus paint
+    qint64 m_pendingUpdateNsecs;    // chart updates since the last paint
+    int m_slowFrames;
+    int m_fastFrames;
+
+    // The plot as last rendered, in device pixels; repaints that leave data,
+    // style and size alone (hover lift, shadow, parent) only blit it
+    QPixmap m_plotCache;
+    bool m_plotCacheValid;
+    bool m_paintingPlot;
+
+    // Statistic overlays, computed once and then kept in step with appends
+    Overlays m_overlays;
+    QString m_overlaySeries;
+    int m_overlayWindow;
+    double m_ewmaAlpha;
+    double m_sigmaBandWidth;
+    FluentSeriesOverlay m_overlay;
+    int m_overlaySourceId;     // series m_overlay follows, -1 when it has to be recomputed
+
+    // Time series: samples held until they can be committed in order, per
+    // series name
+    bool m_timeSeries;
+    QString m_timeFormat;
+    int m_reorderWindow;
+    QHash<QString, FluentReorderBuffer> m_reorderBuffers;
+    QTimer *m_reorderTimer;
+    qint64 m_lateSampleCount;
+
+    // Pie top-N: the selection is kept in step with value changes; each
+    // drill level narrows the pie to the categories of the "Other" above
+    int m_maxSlices;
+    FluentTopNSelector m_pieSelector;
+    QList<QList<qsizetype>> m_pieDrillStack;
+    PieSlices m_pieSlices;
 };
 
+Q_DECLARE_OPERATORS_FOR_FLAGS(FluentGraphCardWidget::Overlays)
+
 #endif // FLUENTGRAPHCARDWIDGET_H
@@ -0,0 +1,531 @@
+#include "fluentgraphrenderer.h"
+
+#include <QFont>
+#include <QFontMetrics>
+#include <QPen>
+#include <QBrush>
+#include <QDateTime>
+
+#include <QtMath>
+
+#include "fluentserieskernels.h"
+
+#include <cmath>
+
+namespace {
+
+// Polylines are stroked in chunks; very long paths make the raster stroker
+// slower than several shorter calls
+const int kPolylineBatch = 4096;
+const int kTickCount = 5;
+const int kLegendHeight = 20;
+const qreal kMarkerSize = 8.0;
+
+QFont labelFont()
+{
+    QFont font;
+    font.setPixelSize(11);
+    return font;
+}
+
+QString tickLabel(double value)
+{
+    return QString::number(value, 'g', 4);
+}
+
+QColor textColor(const FluentGraphScene &scene)
+{
+    return scene.darkMode ? QColor(176, 176, 176) : QColor(102, 102, 102);
+}
+
+QColor gridColor(const FluentGraphScene &scene)
+{
+    return scene.darkMode ? QColor(64, 64, 64) : QColor(229, 229, 229);
+}
+
+} // namespace
+
+void FluentGraphRenderer::paint(QPainter *painter, const QRectF &rect, const FluentGraphScene &scene)
+{
+    if (!painter || rect.isEmpty()) return;
+
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing, scene.antialiased);
+    painter->setFont(labelFont());
+
+    const QRectF plot = plotArea(rect, scene);
+
+    if (scene.kind != FluentGraphScene::Pie) {
+        paintGrid(painter, plot, scene);
+    }
+
+    painter->save();
+    painter->setClipRect(plot.adjusted(-kMarkerSize, -kMarkerSize, kMarkerSize, kMarkerSize));
+    switch (scene.kind) {
+        case FluentGraphScene::Line:
+            paintLines(painter, plot, scene);
+            break;
+        case FluentGraphScene::Bar:
+            paintBars(painter, plot, scene);
+            break;
+        case FluentGraphScene::Pie:
+            paintPie(painter, plot, scene);
+            break;
+        case FluentGraphScene::Scatter:
+            paintScatter(painter, plot, scene);
+            break;
+        case FluentGraphScene::Area:
+            paintAreas(painter, plot, scene);
+            break;
+    }
+    paintOverlays(painter, plot, scene);
+    painter->restore();
+
+    if (scene.showLegend) {
+        paintLegend(painter, rect, scene);
+    }
+
+    painter->restore();
+}
+
+QRectF FluentGraphRenderer::plotArea(const QRectF &rect, const FluentGraphScene &scene)
+{
+    QRectF area = rect.adjusted(0, 8, -12, 0);
+    if (scene.showLegend) {
+        area.setBottom(area.bottom() - kLegendHeight);
+    }
+
+    if (scene.kind == FluentGraphScene::Pie) {
+        // Centered square, leaving room for the exploded slice
+        const qreal side = qMax(0.0, qMin(area.width(), area.height()) - 16.0);
+        return QRectF(area.center().x() - side / 2, area.center().y() - side / 2, side, side);
+    }
+
+    // Room for the y tick labels on the left and the x tick labels below
+    const QFontMetrics metrics(labelFont());
+    int labelWidth = 0;
+    for (int i = 0; i < kTickCount; ++i) {
+        const double value = scene.minY + (scene.maxY - scene.minY) * i / (kTickCount - 1);
+        labelWidth = qMax(labelWidth, metrics.horizontalAdvance(tickLabel(value)));
+    }
+
+    area.setLeft(area.left() + labelWidth + 12);
+    area.setBottom(area.bottom() - metrics.height() - 6);
+    if (area.width() < 0) area.setWidth(0);
+    if (area.height() < 0) area.setHeight(0);
+    return area;
+}
+
+QPointF FluentGraphRenderer::mapToPosition(const QPointF &value, const QRectF &plotArea, const FluentGraphScene &scene)
+{
+    const double spanX = scene.maxX - scene.minX;
+    const double spanY = scene.maxY - scene.minY;
+    return QPointF(plotArea.left() + (spanX > 0 ? (value.x() - scene.minX) / spanX * plotArea.width() : 0.0),
+                   plotArea.bottom() - (spanY > 0 ? (value.y() - scene.minY) / spanY * plotArea.height() : 0.0));
+}
+
+QPointF FluentGraphRenderer::mapToValue(const QPointF &position, const QRectF &plotArea, const FluentGraphScene &scene)
+{
+    const double width = plotArea.width();
+    const double height = plotArea.height();
+    return QPointF(scene.minX + (width > 0 ? (position.x() - plotArea.left()) / width * (scene.maxX - scene.minX) : 0.0),
+                   scene.minY + (height > 0 ? (plotArea.bottom() - position.y()) / height * (scene.maxY - scene.minY) : 0.0));
+}
+
+QImage FluentGraphRenderer::render(const FluentGraphScene &scene, const QSize &size, qreal devicePixelRatio)
+{
+    if (size.isEmpty() || devicePixelRatio <= 0.0) return QImage();
+
+    QImage image(QSize(qCeil(size.width() * devicePixelRatio), qCeil(size.height() * devicePixelRatio)),
+                 QImage::Format_ARGB32_Premultiplied);
+    if (image.isNull()) return image;
+
+    image.setDevicePixelRatio(devicePixelRatio);
+    image.fill(scene.darkMode ? QColor(45, 45, 45) : QColor(255, 255, 255));
+
+    QPainter painter(&image);
+    paint(&painter, QRectF(QPointF(0, 0), QSizeF(size)), scene);
+    painter.end();
+    return image;
+}
+
+QColor FluentGraphRenderer::seriesColor(int index, const QColor &accent)
+{
+    // Accent first, then the Fluent palette
+    static const QColor palette[] = {
+        QColor(232, 17, 35),
+        QColor(16, 124, 16),
+        QColor(255, 185, 0),
+        QColor(135, 100, 184),
+        QColor(0, 183, 195),
+        QColor(202, 80, 16)
+    };
+    const int paletteSize = int(sizeof(palette) / sizeof(palette[0]));
+
+    if (index <= 0) return accent;
+    return palette[(index - 1) % paletteSize];
+}
+
+void FluentGraphRenderer::paintOverlays(QPainter *painter, const QRectF &plot, const FluentGraphScene &scene)
+{
+    painter->setBrush(Qt::NoBrush);
+
+    // Overlay points are always finite, so each one is a single polyline
+    for (const FluentGraphScene::Series &overlay : scene.overlays) {
+        const QList<QPointF> mapped = mapPoints(overlay.points, plot, scene);
+        const QPointF *data = mapped.constData();
+        const qsizetype count = mapped.size();
+
+        QPen pen(overlay.color, 1.5, Qt::DashLine);
+        pen.setJoinStyle(Qt::RoundJoin);
+        painter->setPen(pen);
+
+        for (qsizetype start = 0; start < count - 1; start += kPolylineBatch - 1) {
+            const qsizetype length = qMin(qsizetype(kPolylineBatch), count - start);
+            painter->drawPolyline(data + start, int(length));
+        }
+    }
+}
+
+QList<QPointF> FluentGraphRenderer::mapPoints(const QList<QPointF> &points, const QRectF &plot, const FluentGraphScene &scene)
+{
+    // One pass over the data with the transform folded into two multiply-adds
+    const double spanX = scene.maxX - scene.minX;
+    const double spanY = scene.maxY - scene.minY;
+    const double scaleX = spanX > 0 ? plot.width() / spanX : 0.0;
+    const double scaleY = spanY > 0 ? plot.height() / spanY : 0.0;
+    const double offsetX = plot.left() - scene.minX * scaleX;
+    const double offsetY = plot.bottom() + scene.minY * scaleY;
+
+    QList<QPointF> mapped;
+    mapped.resize(points.size());
+    const QPointF *source = points.constData();
+    QPointF *target = mapped.data();
+    for (qsizetype i = 0; i < points.size(); ++i) {
+        target[i] = QPointF(offsetX + source[i].x() * scaleX, offsetY - source[i].y() * scaleY);
+    }
+    return mapped;
+}
+
+void FluentGraphRenderer::paintGrid(QPainter *painter, const QRectF &plot, const FluentGraphScene &scene)
+{
+    const QFontMetrics metrics(painter->font());
+    const QColor grid = gridColor(scene);
+    const QColor text = textColor(scene);
+
+    for (int i = 0; i < kTickCount; ++i) {
+        const double ratio = double(i) / (kTickCount - 1);
+        const qreal y = plot.bottom() - ratio * plot.height();
+
+        if (scene.showGrid) {
+            painter->setPen(QPen(grid, 1));
+            painter->drawLine(QPointF(plot.left(), y), QPointF(plot.right(), y));
+        }
+
+        painter->setPen(text);
+        const QString label = tickLabel(scene.minY + ratio * (scene.maxY - scene.minY));
+        painter->drawText(QRectF(plot.left() - 200 - 6, y - metrics.height() / 2.0, 200, metrics.height()),
+                          Qt::AlignRight | Qt::AlignVCenter, label);
+    }
+
+    const qreal labelTop = plot.bottom() + 4;
+    if (scene.kind == FluentGraphScene::Bar) {
+        // One label under each category group
+        const int categoryCount = int(scene.categories.size());
+        const qreal groupWidth = categoryCount > 0 ? plot.width() / categoryCount : 0.0;
+        painter->setPen(text);
+        for (int i = 0; i < categoryCount; ++i) {
+            painter->drawText(QRectF(plot.left() + i * groupWidth, labelTop, groupWidth, metrics.height()),
+                              Qt::AlignHCenter | Qt::AlignTop, scene.categories.at(i));
+        }
+        return;
+    }
+
+    for (int i = 0; i < kTickCount; ++i) {
+        const double ratio = double(i) / (kTickCount - 1);
+        const qreal x = plot.left() + ratio * plot.width();
+
+        if (scene.showGrid) {
+            painter->setPen(QPen(grid, 1));
+            painter->drawLine(QPointF(x, plot.top()), QPointF(x, plot.bottom()));
+        }
+
+        painter->setPen(text);
+        const double value = scene.minX + ratio * (scene.maxX - scene.minX);
+        const QString label = scene.timeFormat.isEmpty()
+                                  ? tickLabel(value)
+                                  : QDateTime::fromMSecsSinceEpoch(qint64(value)).toString(scene.timeFormat);
+        painter->drawText(QRectF(x - 50, labelTop, 100, metrics.height()), Qt::AlignHCenter | Qt::AlignTop, label);
+    }
+}
+
+void FluentGraphRenderer::paintLegend(QPainter *painter, const QRectF &rect, const FluentGraphScene &scene)
+{
+    QStringList labels;
+    QList<QColor> colors;
+    if (scene.kind == FluentGraphScene::Pie) {
+        for (int i = 0; i < scene.categories.size(); ++i) {
+            labels << scene.categories.at(i);
+            colors << (scene.series.isEmpty() ? QColor() : seriesColor(i, scene.series.constFirst().color));
+        }
+    } else {
+        for (const FluentGraphScene::Series &series : scene.series) {
+            labels << series.name;
+            colors << series.color;
+        }
+        for (const FluentGraphScene::Series &overlay : scene.overlays) {
+            labels << overlay.name;
+            colors << overlay.color;
+        }
+    }
+
+    if (labels.isEmpty()) return;
+
+    const QFontMetrics metrics(painter->font());
+    const qreal swatch = 10.0;
+    const qreal spacing = 12.0;
+
+    qreal totalWidth = 0;
+    for (const QString &label : labels) {
+        totalWidth += swatch + 4 + metrics.horizontalAdvance(label) + spacing;
+    }
+    totalWidth -= spacing;
+
+    qreal x = rect.left() + qMax(0.0, (rect.width() - totalWidth) / 2);
+    const qreal centerY = rect.bottom() - kLegendHeight / 2.0;
+    for (int i = 0; i < labels.size() && x < rect.right(); ++i) {
+        painter->setPen(Qt::NoPen);
+        painter->setBrush(colors.at(i));
+        painter->drawRect(QRectF(x, centerY - swatch / 2, swatch, swatch));
+        x += swatch + 4;
+
+        const int labelWidth = metrics.horizontalAdvance(labels.at(i));
+        painter->setPen(textColor(scene));
+        painter->drawText(QRectF(x, centerY - metrics.height() / 2.0, labelWidth, metrics.height()),
+                          Qt::AlignLeft | Qt::AlignVCenter, labels.at(i));
+        x += labelWidth + spacing;
+    }
+}
+
+void FluentGraphRenderer::paintLines(QPainter *painter, const QRectF &plot, const FluentGraphScene &scene)
+{
+    painter->setBrush(Qt::NoBrush);
+
+    for (const FluentGraphScene::Series &series : scene.series) {
+        const QList<QPointF> mapped = mapPoints(series.points, plot, scene);
+        const QPointF *data = mapped.constData();
+        const qsizetype count = mapped.size();
+
+        QPen pen(series.color, 2);
+        pen.setJoinStyle(Qt::RoundJoin);
+        painter->setPen(pen);
+
+        // Non-finite points split the line into separate runs
+        qsizetype runStart = 0;
+        while (runStart < count) {
+            while (runStart < count && !(std::isfinite(data[runStart].x()) && std::isfinite(data[runStart].y()))) {
+                ++runStart;
+            }
+            qsizetype runEnd = runStart;
+            while (runEnd < count && std::isfinite(data[runEnd].x()) && std::isfinite(data[runEnd].y())) {
+                ++runEnd;
+            }
+
+            // Consecutive batches share their end point so the line stays joined
+            for (qsizetype start = runStart; start < runEnd - 1; start += kPolylineBatch - 1) {
+                const qsizetype length = qMin(qsizetype(kPolylineBatch), runEnd - start);
+                painter->drawPolyline(data + start, int(length));
+            }
+
+            runStart = runEnd;
+        }
+    }
+}
+
+void FluentGraphRenderer::paintAreas(QPainter *painter, const QRectF &plot, const FluentGraphScene &scene)
+{
+    for (const FluentGraphScene::Series &series : scene.series) {
+        QList<QPointF> outline(series.points.size());
+        outline.resize(FluentSeriesKernels::compactFinite(series.points.constData(), series.points.size(),
+                                                          outline.data()));
+        if (outline.isEmpty()) continue;
+
+        const qsizetype upperCount = outline.size();
+        const QList<QPointF> upper = mapPoints(outline, plot, scene);
+
+        // Close the polygon along the zero baseline
+        const qreal baseline = mapToPosition(QPointF(0, 0), plot, scene).y();
+        QList<QPointF> polygon = upper;
+        polygon.append(QPointF(upper.constLast().x(), baseline));
+        polygon.append(QPointF(upper.constFirst().x(), baseline));
+
+        QColor fill = series.color;
+        fill.setAlpha(100);
+        painter->setPen(Qt::NoPen);
+        painter->setBrush(fill);
+        painter->drawPolygon(polygon.constData(), int(polygon.size()));
+
+        QPen pen(series.color, 2);
+        pen.setJoinStyle(Qt::RoundJoin);
+        painter->setPen(pen);
+        painter->setBrush(Qt::NoBrush);
+        for (qsizetype start = 0; start < upperCount - 1; start += kPolylineBatch - 1) {
+            const qsizetype length = qMin(qsizetype(kPolylineBatch), upperCount - start);
+            painter->drawPolyline(upper.constData() + start, int(length));
+        }
+    }
+}
+
+void FluentGraphRenderer::paintScatter(QPainter *painter, const QRectF &plot, const FluentGraphScene &scene)
+{
+    for (const FluentGraphScene::Series &series : scene.series) {
+        const QList<QPointF> mapped = mapPoints(series.points, plot, scene);
+
+        // A wide round-capped pen turns drawPoints into one batched call for
+        // all circular markers of the series
+        QPen pen(series.color, kMarkerSize);
+        pen.setCapStyle(Qt::RoundCap);
+        painter->setPen(pen);
+
+        for (qsizetype start = 0; start < mapped.size(); start += kPolylineBatch) {
+            const qsizetype length = qMin(qsizetype(kPolylineBatch), mapped.size() - start);
+            painter->drawPoints(mapped.constData() + start, int(length));
+        }
+    }
+}
+
+void FluentGraphRenderer::paintBars(QPainter *painter, const QRectF &plot, const FluentGraphScene &scene)
+{
+    int categoryCount = int(scene.categories.size());
+    for (const FluentGraphScene::Series &series : scene.series) {
+        categoryCount = qMax(categoryCount, int(series.values.size()));
+    }
+    const int setCount = int(scene.series.size());
+    if (categoryCount == 0 || setCount == 0) return;
+
+    const qreal groupWidth = plot.width() / categoryCount;
+    const qreal barWidth = groupWidth * 0.8 / setCount;
+    const qreal baseline = mapToPosition(QPointF(0, 0), plot, scene).y();
+
+    painter->setPen(Qt::NoPen);
+    for (int set = 0; set < setCount; ++set) {
+        const FluentGraphScene::Series &series = scene.series.at(set);
+
+        QList<QRectF> bars;
+        bars.reserve(series.values.size());
+        for (int i = 0; i < series.values.size(); ++i) {
+            const qreal value = series.values.at(i);
+            if (!std::isfinite(value)) continue;
+
+            const qreal top = mapToPosition(QPointF(0, value), plot, scene).y();
+            const qreal left = plot.left() + i * groupWidth + groupWidth * 0.1 + set * barWidth;
+            bars.append(QRectF(left, qMin(top, baseline), barWidth, qAbs(baseline - top)));
+        }
+
+        painter->setBrush(series.color);
+        painter->drawRects(bars.constData(), int(bars.size()));
+    }
+}
+
+void FluentGraphRenderer::paintPie(QPainter *painter, const QRectF &plot, const FluentGraphScene &scene)
+{
+    if (scene.series.isEmpty() || plot.isEmpty()) return;
+
+    const FluentGraphScene::Series &series = scene.series.constFirst();
+    qreal total = 0;
+    for (qreal value : series.values) {
+        if (std::isfinite(value) && value > 0) total += value;
+    }
+    if (total <= 0) return;
+
+    painter->setPen(QPen(scene.darkMode ? QColor(45, 45, 45) : QColor(255, 255, 255), 1));
+
+    // QPainter angles are in 1/16th of a degree, counter-clockwise from 3 o'clock
+    qreal startAngle = 90.0;
+    for (int i = 0; i < series.values.size(); ++i) {
+        const qreal value = series.values.at(i);
+        if (!std::isfinite(value) || value <= 0) continue;
+
+        const qreal span = -360.0 * value / total;
+        QRectF sliceRect = plot;
+
+        // The first slice is exploded, as in the Qt Charts backend
+        if (i == 0) {
+            const qreal middle = qDegreesToRadians(startAngle + span / 2);
+            sliceRect.translate(8 * std::cos(middle), -8 * std::sin(middle));
+        }
+
+        painter->setBrush(seriesColor(i, series.color));
+        painter->drawPie(sliceRect, qRound(startAngle * 16), qRound(span * 16));
+        startAngle += span;
+    }
+}
+
+int FluentGraphRenderer::pieSliceAt(const QPointF &position, const QRectF &plotArea, const FluentGraphScene &scene)
+{
+    if (scene.kind != FluentGraphScene::Pie || scene.series.isEmpty() || plotArea.isEmpty()) return -1;
+
+    const FluentGraphScene::Series &series = scene.series.constFirst();
+    qreal total = 0;
+    for (qreal value : series.values) {
+        if (std::isfinite(value) && value > 0) total += value;
+    }
+    if (total <= 0) return -1;
+
+    // Same layout as paintPie(): clockwise from 12 o'clock, first slice exploded
+    const qreal radius = plotArea.width() / 2;
+    const QPointF offset = position - plotArea.center();
+    qreal clockwise = qRadiansToDegrees(std::atan2(offset.x(), -offset.y()));
+    if (clockwise < 0) clockwise += 360.0;
+
+    qreal startAngle = 0.0;
+    for (int i = 0; i < series.values.size(); ++i) {
+        const qreal value = series.values.at(i);
+        if (!std::isfinite(value) || value <= 0) continue;
+
+        const qreal span = 360.0 * value / total;
+        if (clockwise < startAngle + span) {
+            QPointF center = plotArea.center();
+            if (i == 0) {
+                const qreal middle = qDegreesToRadians(90.0 - startAngle - span / 2);
+                center += QPointF(8 * std::cos(middle), -8 * std::sin(middle));
+            }
+            const QPointF fromCenter = position - center;
+            const qreal distance = std::hypot(fromCenter.x(), fromCenter.y());
+            return distance <= radius ? i : -1;
+        }
+        startAngle += span;
+    }
+    return -1;
+}
+
+FluentGraphRasterView::FluentGraphRasterView(QWidget *parent)
+    : QWidget(parent)
+{
+    // Mouse events are left to the card, which owns hit testing
+    setMouseTracking(true);
+}
+
+void FluentGraphRasterView::setScene(const FluentGraphScene &scene)
+{
+    m_scene = scene;
+    update();
+}
+
+const FluentGraphScene &FluentGraphRasterView::scene() const
+{
+    return m_scene;
+}
+
+QRectF FluentGraphRasterView::plotArea() const
+{
+    return FluentGraphRenderer::plotArea(QRectF(rect()), m_scene);
+}
+
+void FluentGraphRasterView::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event)
+
+    QPainter painter(this);
+    FluentGraphRenderer::paint(&painter, QRectF(rect()), m_scene);
+}
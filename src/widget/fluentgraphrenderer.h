@@ -0,0 +1,110 @@
+#ifndef FLUENTGRAPHRENDERER_H
+#define FLUENTGRAPHRENDERER_H
+
+#include <QWidget>
+#include <QPainter>
+#include <QPaintEvent>
+#include <QColor>
+#include <QImage>
+#include <QList>
+#include <QPointF>
+#include <QRectF>
+#include <QStringList>
+
+// Plain description of what a graph card shows. It holds copies only, so it
+// can be handed to the renderer on any thread.
+struct FluentGraphScene
+{
+    // Same order as FluentGraphCardWidget::GraphType
+    enum Kind {
+        Line,
+        Bar,
+        Pie,
+        Scatter,
+        Area
+    };
+
+    struct Series {
+        QString name;
+        QColor color;
+        QList<QPointF> points;   // Line, scatter and area, in data coordinates
+        QList<qreal> values;     // Bar and pie
+    };
+
+    Kind kind = Line;
+    QList<Series> series;
+    QList<Series> overlays;  // Statistic lines drawn dashed over line, scatter and area charts
+    QStringList categories;
+
+    // Axis ranges in data coordinates
+    double minX = 0.0;
+    double maxX = 1.0;
+    double minY = 0.0;
+    double maxY = 1.0;
+
+    bool showGrid = true;
+    bool showLegend = true;
+    bool darkMode = false;
+    bool antialiased = true;
+
+    // When set, x values are milliseconds since the epoch and x labels are
+    // dates/times in this QDateTime format
+    QString timeFormat;
+};
+
+// QPainter implementation of the graph card charts. Everything is drawn from
+// contiguous coordinate arrays with one batched call per series, without a
+// QGraphicsScene in between.
+class FluentGraphRenderer
+{
+public:
+    static void paint(QPainter *painter, const QRectF &rect, const FluentGraphScene &scene);
+
+    // Paints the scene on the card background into a new image of size
+    // device-independent pixels. Uses no widget, so it may run on any thread.
+    static QImage render(const FluentGraphScene &scene, const QSize &size, qreal devicePixelRatio = 1.0);
+
+    // Geometry of the plot inside rect and the mapping between data and pixels
+    static QRectF plotArea(const QRectF &rect, const FluentGraphScene &scene);
+    static QPointF mapToPosition(const QPointF &value, const QRectF &plotArea, const FluentGraphScene &scene);
+    static QPointF mapToValue(const QPointF &position, const QRectF &plotArea, const FluentGraphScene &scene);
+
+    // Index into the values of the pie slice under position, -1 for none
+    static int pieSliceAt(const QPointF &position, const QRectF &plotArea, const FluentGraphScene &scene);
+
+    static QColor seriesColor(int index, const QColor &accent);
+
+private:
+    static void paintGrid(QPainter *painter, const QRectF &plot, const FluentGraphScene &scene);
+    static void paintLegend(QPainter *painter, const QRectF &rect, const FluentGraphScene &scene);
+    static void paintLines(QPainter *painter, const QRectF &plot, const FluentGraphScene &scene);
+    static void paintAreas(QPainter *painter, const QRectF &plot, const FluentGraphScene &scene);
+    static void paintScatter(QPainter *painter, const QRectF &plot, const FluentGraphScene &scene);
+    static void paintBars(QPainter *painter, const QRectF &plot, const FluentGraphScene &scene);
+    static void paintPie(QPainter *painter, const QRectF &plot, const FluentGraphScene &scene);
+    static void paintOverlays(QPainter *painter, const QRectF &plot, const FluentGraphScene &scene);
+
+    static QList<QPointF> mapPoints(const QList<QPointF> &points, const QRectF &plot, const FluentGraphScene &scene);
+};
+
+// Chart area of a graph card using the raster backend
+class FluentGraphRasterView : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit FluentGraphRasterView(QWidget *parent = nullptr);
+
+    void setScene(const FluentGraphScene &scene);
+    const FluentGraphScene &scene() const;
+
+    QRectF plotArea() const;
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+
+private:
+    FluentGraphScene m_scene;
+};
+
+#endif // FLUENTGRAPHRENDERER_H
@@ -0,0 +1,176 @@
+#include "fluenthittestindex.h"
+
+#include <QtMath>
+
+#include <algorithm>
+
+namespace {
+
+// Grid cells are a little larger than the hover tolerance, so a query
+// touches at most a 2x2 block of them
+const double kCellSize = 16.0;
+
+}
+
+FluentHitTestIndex::FluentHitTestIndex()
+    : m_scaleX(1.0)
+    , m_scaleY(1.0)
+    , m_columns(1)
+{
+}
+
+void FluentHitTestIndex::clear()
+{
+    m_sorted.clear();
+    m_grid.clear();
+    m_cells.clear();
+    m_cellStarts.clear();
+}
+
+bool FluentHitTestIndex::isEmpty() const
+{
+    return m_sorted.isEmpty() && m_grid.isEmpty();
+}
+
+void FluentHitTestIndex::setMapping(const QPointF &value0, const QPointF &position0,
+                                    const QPointF &value1, const QPointF &position1, const QRectF &bounds)
+{
+    clear();
+
+    // Mapping relative to value0 keeps precision for large values such as
+    // timestamps, where an offset from zero would cancel out
+    m_value0 = value0;
+    m_position0 = position0;
+    m_scaleX = value1.x() != value0.x() ? (position1.x() - position0.x()) / (value1.x() - value0.x()) : 0.0;
+    m_scaleY = value1.y() != value0.y() ? (position1.y() - position0.y()) / (value1.y() - value0.y()) : 0.0;
+    m_bounds = bounds.normalized();
+    m_columns = qMax(1, qCeil(m_bounds.width() / kCellSize) + 1);
+}
+
+void FluentHitTestIndex::addSeries(int id, const QList<QPointF> &points, bool bucketed)
+{
+    if (points.isEmpty()) return;
+
+    // Points leaving the plot area are not drawn and cannot be hovered
+    const QRectF bounds = m_bounds.adjusted(-1.0, -1.0, 1.0, 1.0);
+
+    if (!bucketed) {
+        SortedSeries series{id, QList<double>(), QList<double>(), QList<int>()};
+        series.x.reserve(points.size());
+        series.y.reserve(points.size());
+        series.indices.reserve(points.size());
+
+        for (qsizetype i = 0; i < points.size(); ++i) {
+            const QPointF position = mapToPosition(points.at(i));
+            if (!bounds.contains(position)) continue;
+
+            // A single step back in x rules out the binary search
+            if (!series.x.isEmpty() && position.x() < series.x.last()) {
+                bucketed = true;
+                break;
+            }
+            series.x.append(position.x());
+            series.y.append(position.y());
+            series.indices.append(int(i));
+        }
+
+        if (!bucketed) {
+            if (!series.x.isEmpty()) {
+                m_sorted.append(series);
+            }
+            return;
+        }
+    }
+
+    const qsizetype previous = m_grid.size();
+    for (qsizetype i = 0; i < points.size(); ++i) {
+        const QPointF position = mapToPosition(points.at(i));
+        if (!bounds.contains(position)) continue;
+
+        m_grid.append(GridEntry{cellAt(position.x(), position.y()), id, int(i), position.x(), position.y()});
+    }
+
+    if (m_grid.size() > previous) {
+        buildGrid(previous);
+    }
+}
+
+QPair<int, int> FluentHitTestIndex::pointAt(const QPointF &position, qreal tolerance) const
+{
+    QPair<int, int> result(-1, -1);
+    qreal best = tolerance;
+
+    const double px = position.x();
+    const double py = position.y();
+
+    for (const SortedSeries &series : m_sorted) {
+        auto first = std::lower_bound(series.x.constBegin(), series.x.constEnd(), px - tolerance);
+        for (auto it = first; it != series.x.constEnd() && *it <= px + tolerance; ++it) {
+            const qsizetype i = it - series.x.constBegin();
+            const qreal distance = qAbs(*it - px) + qAbs(series.y.at(i) - py);
+            if (distance <= best) {
+                best = distance;
+                result = qMakePair(series.id, series.indices.at(i));
+            }
+        }
+    }
+
+    if (m_cells.isEmpty()) return result;
+
+    const int firstColumn = qMax(0, qFloor((px - tolerance - m_bounds.left()) / kCellSize));
+    const int lastColumn = qMin(m_columns - 1, qFloor((px + tolerance - m_bounds.left()) / kCellSize));
+    const int firstRow = qMax(0, qFloor((py - tolerance - m_bounds.top()) / kCellSize));
+    const int lastRow = qFloor((py + tolerance - m_bounds.top()) / kCellSize);
+
+    for (int row = firstRow; row <= lastRow; ++row) {
+        for (int column = firstColumn; column <= lastColumn; ++column) {
+            const qint64 cell = qint64(row) * m_columns + column;
+            auto found = std::lower_bound(m_cells.constBegin(), m_cells.constEnd(), cell);
+            if (found == m_cells.constEnd() || *found != cell) continue;
+
+            const qsizetype run = found - m_cells.constBegin();
+            const int end = run + 1 < m_cellStarts.size() ? m_cellStarts.at(run + 1) : int(m_grid.size());
+            for (int i = m_cellStarts.at(run); i < end; ++i) {
+                const GridEntry &entry = m_grid.at(i);
+                const qreal distance = qAbs(entry.x - px) + qAbs(entry.y - py);
+                if (distance <= best) {
+                    best = distance;
+                    result = qMakePair(entry.series, entry.index);
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+QPointF FluentHitTestIndex::mapToPosition(const QPointF &value) const
+{
+    return QPointF(m_position0.x() + (value.x() - m_value0.x()) * m_scaleX,
+                   m_position0.y() + (value.y() - m_value0.y()) * m_scaleY);
+}
+
+qint64 FluentHitTestIndex::cellAt(double x, double y) const
+{
+    const int column = qBound(0, qFloor((x - m_bounds.left()) / kCellSize), m_columns - 1);
+    const int row = qMax(0, qFloor((y - m_bounds.top()) / kCellSize));
+    return qint64(row) * m_columns + column;
+}
+
+void FluentHitTestIndex::buildGrid(qsizetype appendedFrom)
+{
+    // Entries stay sorted by cell: sort the new series, merge it in and
+    // record where every occupied cell starts
+    const auto byCell = [](const GridEntry &a, const GridEntry &b) { return a.cell < b.cell; };
+    std::sort(m_grid.begin() + appendedFrom, m_grid.end(), byCell);
+    std::inplace_merge(m_grid.begin(), m_grid.begin() + appendedFrom, m_grid.end(), byCell);
+
+    m_cells.clear();
+    m_cellStarts.clear();
+    for (qsizetype i = 0; i < m_grid.size(); ++i) {
+        if (m_cells.isEmpty() || m_cells.last() != m_grid.at(i).cell) {
+            m_cells.append(m_grid.at(i).cell);
+            m_cellStarts.append(int(i));
+        }
+    }
+}
@@ -0,0 +1,69 @@
+#ifndef FLUENTHITTESTINDEX_H
+#define FLUENTHITTESTINDEX_H
+
+#include <QList>
+#include <QPair>
+#include <QPointF>
+#include <QRectF>
+
+// Screen-space lookup of the points on a graph card. Built once per layout or
+// data change from the points handed to the chart, it answers hover queries
+// without mapping every point again: series ordered by x are binary searched
+// on their screen x, everything else is bucketed into a uniform grid.
+class FluentHitTestIndex
+{
+public:
+    FluentHitTestIndex();
+
+    void clear();
+    bool isEmpty() const;
+
+    // Data to screen mapping, given as two points in data coordinates and
+    // where they land on screen. Points outside bounds are not indexed.
+    void setMapping(const QPointF &value0, const QPointF &position0,
+                    const QPointF &value1, const QPointF &position1, const QRectF &bounds);
+
+    // Adds one series of on-screen points. Unless bucketed is set, series
+    // with non-decreasing x use the binary search path.
+    void addSeries(int id, const QList<QPointF> &points, bool bucketed);
+
+    // Closest indexed point within tolerance (Manhattan distance, as
+    // isPointNearMouse) as (series id, point index), or (-1, -1)
+    QPair<int, int> pointAt(const QPointF &position, qreal tolerance) const;
+
+private:
+    struct SortedSeries {
+        int id;
+        QList<double> x;
+        QList<double> y;
+        QList<int> indices;     // point index behind every screen position
+    };
+
+    struct GridEntry {
+        qint64 cell;
+        int series;
+        int index;
+        double x;
+        double y;
+    };
+
+    QPointF mapToPosition(const QPointF &value) const;
+    qint64 cellAt(double x, double y) const;
+    void buildGrid(qsizetype appendedFrom);
+
+    QPointF m_value0;
+    QPointF m_position0;
+    double m_scaleX;
+    double m_scaleY;
+    QRectF m_bounds;
+
+    QList<SortedSeries> m_sorted;
+
+    // Grid entries sorted by cell; m_cells/m_cellStarts index the runs
+    QList<GridEntry> m_grid;
+    QList<qint64> m_cells;
+    QList<int> m_cellStarts;
+    int m_columns;
+};
+
+#endif // FLUENTHITTESTINDEX_H
@@ -1,4 +1,5 @@
 #include "fluentlistcardwidget.h"
+#include "fluentperf.h"
 #include <QApplication>
 #include <QPalette>
 #include <QScrollBar>
@@ -251,6 +252,7 @@ void FluentListCardWidget::setupShadowEffect()
 void FluentListCardWidget::setupHoverAnimation()
 {
     m_hoverAnimation = new QPropertyAnimation(this, "pos", this);
+    FLUENT_PERF_ANIMATION(m_hoverAnimation);
     m_hoverAnimation->setDuration(200);
     m_hoverAnimation->setEasingCurve(QEasingCurve::OutCubic);
 }
@@ -269,6 +271,7 @@ void FluentListCardWidget::updateTheme()
 
 void FluentListCardWidget::updateStyles()
 {
+    FLUENT_PERF_SCOPE(StyleUpdate);
     QString cardStyle;
     QString buttonStyle;
 
@@ -401,6 +404,7 @@ void FluentListCardWidget::updateHeaderIcon()
 
 void FluentListCardWidget::updatePagination()
 {
+    FLUENT_PERF_SCOPE(Pagination);
     updateListView();
     updatePaginationDots();
     updateNavigationButtons();
@@ -504,6 +508,7 @@ void FluentListCardWidget::leaveEvent(QEvent *event)
 
 void FluentListCardWidget::paintEvent(QPaintEvent *event)
 {
+    FLUENT_PERF_SCOPE(Paint);
     QStyleOption opt;
     opt.initFrom(this);
     QPainter p(this);
@@ -0,0 +1,257 @@
+#include "fluentlodpyramid.h"
+#include "fluentchartdecimator.h"
+
+#include <cmath>
+
+FluentLodPyramid::FluentLodPyramid()
+    : m_offset(0)
+    , m_end(0)
+    , m_lastInversion(-1)
+{
+}
+
+void FluentLodPyramid::clear()
+{
+    m_levels.clear();
+    m_firstBlock.clear();
+    m_offset = 0;
+    m_end = 0;
+    m_lastInversion = -1;
+}
+
+void FluentLodPyramid::rebuild(FluentSpan<double> x, FluentSpan<double> y)
+{
+    clear();
+    m_end = y.size();
+    for (qsizetype i = 0; i < m_end; ++i) {
+        addPoint(x, y, i);
+    }
+}
+
+void FluentLodPyramid::sync(FluentSpan<double> x, FluentSpan<double> y, qsizetype appended, qsizetype removed)
+{
+    const qsizetype previousEnd = m_end;
+    m_end += appended;
+    m_offset += removed;
+
+    // Anything that doesn't add up (the window was replaced behind our back)
+    // is handled by starting over
+    if (m_end - m_offset != y.size()) {
+        rebuild(x, y);
+        return;
+    }
+
+    dropStaleBlocks();
+
+    for (qsizetype index = qMax(previousEnd, m_offset); index < m_end; ++index) {
+        addPoint(x, y, index);
+    }
+}
+
+qsizetype FluentLodPyramid::size() const
+{
+    return m_end - m_offset;
+}
+
+bool FluentLodPyramid::isSorted() const
+{
+    return m_lastInversion <= m_offset;
+}
+
+QList<QPointF> FluentLodPyramid::envelope(FluentSpan<double> x, FluentSpan<double> y, qsizetype first,
+                                          qsizetype last, qsizetype buckets, QList<qsizetype> *rawIndices) const
+{
+    first = qBound(qsizetype(0), first, y.size());
+    last = qBound(first, last, y.size());
+    buckets = qMax(buckets, qsizetype(1));
+    const qsizetype count = last - first;
+
+    // Short ranges (or a pyramid without levels yet) are reduced straight
+    // from the raw points
+    if (count <= 2 * buckets || m_levels.isEmpty()) {
+        QList<QPointF> result = FluentChartDecimator::minMaxEnvelope(x.data() + first, y.data() + first,
+                                                                     count, buckets, rawIndices);
+        if (rawIndices) {
+            for (qsizetype &index : *rawIndices) {
+                index += first;
+            }
+        }
+        return result;
+    }
+
+    // Pick the finest level that brings the range down to at most one block
+    // per bucket
+    int level = 0;
+    while (level + 1 < m_levels.size() && (count >> (level + 1)) > buckets) {
+        ++level;
+    }
+
+    QList<QPointF> result;
+    result.reserve(2 * buckets + 4);
+    if (rawIndices) {
+        rawIndices->clear();
+        rawIndices->reserve(2 * buckets + 4);
+    }
+
+    auto take = [&](const Block &block) {
+        if (block.minIndex < 0) return;
+        const qsizetype low = qMin(block.minIndex, block.maxIndex) - m_offset;
+        const qsizetype high = qMax(block.minIndex, block.maxIndex) - m_offset;
+        result.append(QPointF(x[low], y[low]));
+        if (rawIndices) rawIndices->append(low);
+        if (high != low) {
+            result.append(QPointF(x[high], y[high]));
+            if (rawIndices) rawIndices->append(high);
+        }
+    };
+
+    const qsizetype blockSize = qsizetype(2) << level;
+    const qsizetype begin = first + m_offset;
+    const qsizetype end = last + m_offset;
+    const qsizetype firstWhole = (begin + blockSize - 1) / blockSize;
+    const qsizetype lastWhole = end / blockSize;
+
+    // Partial blocks at either edge are scanned, whole blocks come from the level
+    take(scan(y, begin, qMin(firstWhole * blockSize, end)));
+    for (qsizetype number = firstWhole; number < lastWhole; ++number) {
+        const Block *stored = block(level, number);
+        take(stored ? *stored : scan(y, number * blockSize, (number + 1) * blockSize));
+    }
+    if (lastWhole >= firstWhole) {
+        take(scan(y, lastWhole * blockSize, end));
+    }
+
+    return result;
+}
+
+bool FluentLodPyramid::yRange(FluentSpan<double> y, qsizetype first, qsizetype last,
+                              double *minY, double *maxY) const
+{
+    first = qBound(qsizetype(0), first, y.size());
+    last = qBound(first, last, y.size());
+
+    Block total = emptyBlock();
+    qsizetype index = first + m_offset;
+    const qsizetype end = last + m_offset;
+
+    // Greedily cover the range with the largest aligned blocks available
+    while (index < end) {
+        bool covered = false;
+        for (int level = int(m_levels.size()) - 1; level >= 0; --level) {
+            const qsizetype blockSize = qsizetype(2) << level;
+            if (index % blockSize != 0 || index + blockSize > end) continue;
+
+            if (const Block *stored = block(level, index / blockSize)) {
+                total = merge(total, *stored);
+                index += blockSize;
+                covered = true;
+                break;
+            }
+        }
+
+        if (!covered) {
+            total = merge(total, scan(y, index, index + 1));
+            ++index;
+        }
+    }
+
+    if (total.minIndex < 0) return false;
+
+    if (minY) *minY = total.minY;
+    if (maxY) *maxY = total.maxY;
+    return true;
+}
+
+FluentLodPyramid::Block FluentLodPyramid::emptyBlock()
+{
+    return Block{0.0, 0.0, -1, -1};
+}
+
+FluentLodPyramid::Block FluentLodPyramid::merge(const Block &a, const Block &b)
+{
+    if (a.minIndex < 0) return b;
+    if (b.minIndex < 0) return a;
+
+    Block merged = a;
+    if (b.minY < merged.minY) {
+        merged.minY = b.minY;
+        merged.minIndex = b.minIndex;
+    }
+    if (b.maxY > merged.maxY) {
+        merged.maxY = b.maxY;
+        merged.maxIndex = b.maxIndex;
+    }
+    return merged;
+}
+
+FluentLodPyramid::Block FluentLodPyramid::scan(FluentSpan<double> y, qsizetype from, qsizetype to) const
+{
+    Block result = emptyBlock();
+    for (qsizetype index = from; index < to; ++index) {
+        const double value = y[index - m_offset];
+        if (!std::isfinite(value)) continue;
+        result = merge(result, Block{value, value, index, index});
+    }
+    return result;
+}
+
+const FluentLodPyramid::Block *FluentLodPyramid::block(int level, qsizetype number) const
+{
+    if (level < 0 || level >= m_levels.size()) return nullptr;
+
+    const qsizetype position = number - m_firstBlock.at(level);
+    const QList<Block> &blocks = m_levels.at(level);
+    if (position < 0 || position >= blocks.size()) return nullptr;
+
+    // A block that straddles the front of the window still holds dropped points
+    if (number * (qsizetype(2) << level) < m_offset) return nullptr;
+
+    return &blocks.at(position);
+}
+
+void FluentLodPyramid::addPoint(FluentSpan<double> x, FluentSpan<double> y, qsizetype index)
+{
+    if (index > m_offset && !(x[index - m_offset - 1] <= x[index - m_offset])) {
+        m_lastInversion = index;
+    }
+
+    // Every second point completes a block on the lowest level
+    if (index % 2 == 1 && index - 1 >= m_offset) {
+        pushBlock(0, index / 2, scan(y, index - 1, index + 1));
+    }
+}
+
+void FluentLodPyramid::pushBlock(int level, qsizetype number, const Block &block)
+{
+    if (level >= m_levels.size()) {
+        m_levels.append(QList<Block>());
+        m_firstBlock.append(number);
+    }
+
+    QList<Block> &blocks = m_levels[level];
+    if (blocks.isEmpty() || m_firstBlock.at(level) + blocks.size() != number) {
+        // Levels only ever grow at the back; a gap means the front moved past us
+        blocks.clear();
+        m_firstBlock[level] = number;
+    }
+    blocks.append(block);
+
+    // Every second block completes one on the level above
+    if (number % 2 == 1 && blocks.size() >= 2) {
+        const Block merged = merge(blocks.at(blocks.size() - 2), blocks.constLast());
+        pushBlock(level + 1, number / 2, merged);
+    }
+}
+
+void FluentLodPyramid::dropStaleBlocks()
+{
+    for (int level = 0; level < m_levels.size(); ++level) {
+        const qsizetype blockSize = qsizetype(2) << level;
+        QList<Block> &blocks = m_levels[level];
+        const qsizetype stale = qBound(qsizetype(0), m_offset / blockSize - m_firstBlock.at(level), blocks.size());
+        if (stale > 0) {
+            blocks.remove(0, stale);
+            m_firstBlock[level] += stale;
+        }
+    }
+}
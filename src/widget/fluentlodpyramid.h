@@ -0,0 +1,66 @@
+#ifndef FLUENTLODPYRAMID_H
+#define FLUENTLODPYRAMID_H
+
+#include <QList>
+#include <QPointF>
+
+#include "fluentseriestable.h"
+
+// Min/max level-of-detail pyramid over one series. Level k summarises blocks
+// of 2^(k+1) consecutive points, so the envelope of any index range can be
+// produced from roughly one block per output pixel instead of every point.
+//
+// The pyramid is keyed by absolute point indices: appending points and
+// dropping them from the front (retention) are both incremental, and the
+// caller passes the current window of x and y columns to every query.
+class FluentLodPyramid
+{
+public:
+    FluentLodPyramid();
+
+    void clear();
+    void rebuild(FluentSpan<double> x, FluentSpan<double> y);
+
+    // Bring the pyramid in line with a window that gained `appended` points at
+    // the back and lost `removed` points at the front
+    void sync(FluentSpan<double> x, FluentSpan<double> y, qsizetype appended, qsizetype removed);
+
+    qsizetype size() const;
+
+    // True while x never decreases across the window, which index range
+    // lookups by x rely on
+    bool isSorted() const;
+
+    // Min/max envelope of points [first, last) with at most about
+    // 2 * buckets points, in index order
+    QList<QPointF> envelope(FluentSpan<double> x, FluentSpan<double> y, qsizetype first, qsizetype last,
+                            qsizetype buckets, QList<qsizetype> *rawIndices = nullptr) const;
+
+    // Finite extent of y[first, last)
+    bool yRange(FluentSpan<double> y, qsizetype first, qsizetype last, double *minY, double *maxY) const;
+
+private:
+    struct Block {
+        double minY;
+        double maxY;
+        qsizetype minIndex;   // absolute, -1 when the block has no finite y
+        qsizetype maxIndex;
+    };
+
+    static Block emptyBlock();
+    static Block merge(const Block &a, const Block &b);
+    Block scan(FluentSpan<double> y, qsizetype from, qsizetype to) const;
+    const Block *block(int level, qsizetype number) const;
+
+    void addPoint(FluentSpan<double> x, FluentSpan<double> y, qsizetype index);
+    void pushBlock(int level, qsizetype number, const Block &block);
+    void dropStaleBlocks();
+
+    QList<QList<Block>> m_levels;
+    QList<qsizetype> m_firstBlock;   // block number of m_levels[k].first()
+    qsizetype m_offset;              // absolute index of points[0]
+    qsizetype m_end;                 // absolute index past the last point
+    qsizetype m_lastInversion;       // last absolute index whose x went backwards
+};
+
+#endif // FLUENTLODPYRAMID_H
@@ -0,0 +1,201 @@
+#include "fluentmappedseriesfile.h"
+
+#include <QtEndian>
+
+#include <cstring>
+
+namespace {
+
+const char kMagic[8] = {'F', 'L', 'U', 'E', 'N', 'T', 'T', 'S'};
+const quint32 kVersion = 1;
+const qint64 kHeaderSize = 32;
+const qint64 kNameSize = 64;
+
+}
+
+FluentMappedSeriesFile::FluentMappedSeriesFile(const QString &fileName)
+    : m_file(fileName)
+    , m_data(nullptr)
+    , m_size(0)
+    , m_seriesCount(0)
+    , m_capacity(0)
+    , m_rowCount(0)
+{
+}
+
+FluentMappedSeriesFile::~FluentMappedSeriesFile()
+{
+    close();
+}
+
+bool FluentMappedSeriesFile::isMappedSeriesFile(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) return false;
+
+    char magic[sizeof(kMagic)];
+    return file.read(magic, sizeof(magic)) == qint64(sizeof(magic))
+           && std::memcmp(magic, kMagic, sizeof(kMagic)) == 0;
+}
+
+bool FluentMappedSeriesFile::open()
+{
+    close();
+
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+    // Columns are mapped as native doubles, which only little-endian hosts can do
+    m_errorString = QStringLiteral("Mapped series files are not supported on big-endian hosts");
+    return false;
+#endif
+
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        m_errorString = m_file.errorString();
+        return false;
+    }
+
+    m_size = m_file.size();
+    m_data = m_size >= kHeaderSize ? m_file.map(0, m_size) : nullptr;
+    if (!m_data) {
+        m_errorString = m_size < kHeaderSize ? QStringLiteral("File is too small for a series header")
+                                             : m_file.errorString();
+        close();
+        return false;
+    }
+
+    quint32 seriesCount = 0;
+    quint64 capacity = 0;
+    quint64 rowCount = 0;
+    if (!readLayout(&seriesCount, &capacity, &rowCount)) {
+        close();
+        return false;
+    }
+
+    m_seriesCount = int(seriesCount);
+    m_capacity = qsizetype(capacity);
+    m_rowCount = qsizetype(rowCount);
+
+    for (int i = 0; i < m_seriesCount; ++i) {
+        const char *name = reinterpret_cast<const char *>(m_data + kHeaderSize + i * kNameSize);
+        const QString seriesName = QString::fromUtf8(name, qstrnlen(name, kNameSize));
+        m_seriesNames.append(seriesName.isEmpty() ? QStringLiteral("Series %1").arg(i + 1) : seriesName);
+    }
+
+    return true;
+}
+
+void FluentMappedSeriesFile::close()
+{
+    if (m_data) {
+        m_file.unmap(m_data);
+        m_data = nullptr;
+    }
+    m_file.close();
+
+    m_size = 0;
+    m_seriesCount = 0;
+    m_capacity = 0;
+    m_rowCount = 0;
+    m_seriesNames.clear();
+}
+
+bool FluentMappedSeriesFile::isOpen() const
+{
+    return m_data != nullptr;
+}
+
+QString FluentMappedSeriesFile::fileName() const
+{
+    return m_file.fileName();
+}
+
+QString FluentMappedSeriesFile::errorString() const
+{
+    return m_errorString;
+}
+
+bool FluentMappedSeriesFile::refresh()
+{
+    if (!m_data) return false;
+
+    // A rewritten capture has a different size; the mapping would no longer
+    // cover it (or would cover freed pages), so it has to be reopened
+    if (QFile(m_file.fileName()).size() != m_size) return false;
+
+    quint32 seriesCount = 0;
+    quint64 capacity = 0;
+    quint64 rowCount = 0;
+    if (!readLayout(&seriesCount, &capacity, &rowCount)) return false;
+    if (int(seriesCount) != m_seriesCount || qsizetype(capacity) != m_capacity) return false;
+
+    // Rows are only ever added
+    if (qsizetype(rowCount) < m_rowCount) return false;
+
+    m_rowCount = qsizetype(rowCount);
+    return true;
+}
+
+int FluentMappedSeriesFile::seriesCount() const
+{
+    return m_seriesCount;
+}
+
+QString FluentMappedSeriesFile::seriesName(int series) const
+{
+    return m_seriesNames.value(series);
+}
+
+qsizetype FluentMappedSeriesFile::rowCount() const
+{
+    return m_rowCount;
+}
+
+FluentSpan<double> FluentMappedSeriesFile::xValues() const
+{
+    return m_data ? FluentSpan<double>(column(0), m_rowCount) : FluentSpan<double>();
+}
+
+FluentSpan<double> FluentMappedSeriesFile::yValues(int series) const
+{
+    if (!m_data || series < 0 || series >= m_seriesCount) return FluentSpan<double>();
+    return FluentSpan<double>(column(series + 1), m_rowCount);
+}
+
+bool FluentMappedSeriesFile::readLayout(quint32 *seriesCount, quint64 *capacity, quint64 *rowCount)
+{
+    if (std::memcmp(m_data, kMagic, sizeof(kMagic)) != 0) {
+        m_errorString = QStringLiteral("Not a mapped series file");
+        return false;
+    }
+
+    const quint32 version = qFromLittleEndian<quint32>(m_data + 8);
+    *seriesCount = qFromLittleEndian<quint32>(m_data + 12);
+    *capacity = qFromLittleEndian<quint64>(m_data + 16);
+    *rowCount = qFromLittleEndian<quint64>(m_data + 24);
+
+    if (*capacity == 0) {
+        *capacity = *rowCount;
+    }
+
+    // Every size is checked against the file before a column is exposed;
+    // the limits keep the products below from overflowing
+    const quint64 available = quint64(m_size);
+    const bool valid = version == kVersion
+                       && *seriesCount > 0 && *seriesCount <= 65535
+                       && *capacity <= available / sizeof(double)
+                       && *rowCount <= *capacity
+                       && quint64(kHeaderSize + *seriesCount * kNameSize)
+                              + (*seriesCount + 1) * *capacity * sizeof(double) <= available;
+
+    if (!valid) {
+        m_errorString = QStringLiteral("Invalid mapped series header");
+    }
+    return valid;
+}
+
+const double *FluentMappedSeriesFile::column(int index) const
+{
+    // Header and name slots are multiples of 8 bytes, so every column is
+    // aligned for double access within the page-aligned mapping
+    const qint64 offset = kHeaderSize + m_seriesCount * kNameSize + index * m_capacity * qint64(sizeof(double));
+    return reinterpret_cast<const double *>(m_data + offset);
+}
@@ -0,0 +1,68 @@
+#ifndef FLUENTMAPPEDSERIESFILE_H
+#define FLUENTMAPPEDSERIESFILE_H
+
+#include <QFile>
+#include <QString>
+#include <QStringList>
+
+#include "fluentseriestable.h"
+
+// Read-only memory mapping of a binary series capture. Columns are read in
+// place from the mapping, so opening a multi-gigabyte file costs no copy.
+//
+// Layout, little-endian throughout:
+//
+//   offset 0   char[8]   magic "FLUENTTS"
+//          8   uint32    version, currently 1
+//         12   uint32    series count n (number of y columns)
+//         16   uint64    capacity: rows reserved per column, 0 = row count
+//         24   uint64    row count: rows written so far
+//         32   n x char[64]  UTF-8 series names, NUL padded
+//              float64[capacity]       x column
+//              n x float64[capacity]   y columns, one per series
+//
+// A writer appends by filling the next rows of every column and only then
+// raising the row count in the header. The file must not shrink while it is
+// mapped; a capture that outgrows its capacity is rewritten with a larger
+// one, which readers detect as a layout change.
+class FluentMappedSeriesFile
+{
+public:
+    explicit FluentMappedSeriesFile(const QString &fileName);
+    ~FluentMappedSeriesFile();
+
+    // True if the file starts with the magic above
+    static bool isMappedSeriesFile(const QString &fileName);
+
+    bool open();
+    void close();
+    bool isOpen() const;
+    QString fileName() const;
+    QString errorString() const;
+
+    // Re-reads the row count after the file changed. Returns false if the
+    // layout no longer matches the mapping and the file has to be reopened.
+    bool refresh();
+
+    int seriesCount() const;
+    QString seriesName(int series) const;
+    qsizetype rowCount() const;
+
+    FluentSpan<double> xValues() const;
+    FluentSpan<double> yValues(int series) const;
+
+private:
+    bool readLayout(quint32 *seriesCount, quint64 *capacity, quint64 *rowCount);
+    const double *column(int index) const;
+
+    QFile m_file;
+    uchar *m_data;
+    qint64 m_size;
+    int m_seriesCount;
+    qsizetype m_capacity;
+    qsizetype m_rowCount;
+    QStringList m_seriesNames;
+    QString m_errorString;
+};
+
+#endif // FLUENTMAPPEDSERIESFILE_H
@@ -1,4 +1,5 @@
 #include "fluentmessagebarwidget.h"
+#include "fluentperf.h"
 #include <QApplication>
 #include <QPalette>
 
@@ -109,11 +110,13 @@ void FluentMessageBarWidget::setupUI()
     setGraphicsEffect(m_opacityEffect);
 
     m_showAnimation = new QPropertyAnimation(m_opacityEffect, "opacity", this);
+    FLUENT_PERF_ANIMATION(m_showAnimation);
     m_showAnimation->setDuration(300);
     m_showAnimation->setEasingCurve(QEasingCurve::OutCubic);
     connect(m_showAnimation, &QPropertyAnimation::finished, this, &FluentMessageBarWidget::onShowAnimationFinished);
 
     m_hideAnimation = new QPropertyAnimation(m_opacityEffect, "opacity", this);
+    FLUENT_PERF_ANIMATION(m_hideAnimation);
     m_hideAnimation->setDuration(200);
     m_hideAnimation->setEasingCurve(QEasingCurve::InCubic);
     connect(m_hideAnimation, &QPropertyAnimation::finished, this, &FluentMessageBarWidget::onHideAnimationFinished);
@@ -126,6 +129,7 @@ void FluentMessageBarWidget::setupUI()
 
 void FluentMessageBarWidget::updateStyles()
 {
+    FLUENT_PERF_SCOPE(StyleUpdate);
     QString backgroundColor = getTypeBackgroundColor();
     QString textColor = getTypeTextColor();
     QColor typeColor = getTypeColor();
@@ -455,6 +459,7 @@ void FluentMessageBarWidget::onHideAnimationFinished()
 
 void FluentMessageBarWidget::paintEvent(QPaintEvent *event)
 {
+    FLUENT_PERF_SCOPE(Paint);
     QStyleOption opt;
     opt.initFrom(this);
     QPainter p(this);
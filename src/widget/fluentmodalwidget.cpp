@@ -1,4 +1,5 @@
 #include "fluentmodalwidget.h"
+#include "fluentperf.h"
 #include <QApplication>
 #include <QPalette>
 #include <QKeyEvent>
@@ -166,11 +167,13 @@ void FluentModalWidget::setupAnimations()
 
     // Scale animation
     m_scaleAnimation = new QPropertyAnimation(this, "geometry", this);
+    FLUENT_PERF_ANIMATION(m_scaleAnimation);
     m_scaleAnimation->setDuration(300);
     m_scaleAnimation->setEasingCurve(QEasingCurve::OutCubic);
 
     // Opacity animation
     m_opacityAnimation = new QPropertyAnimation(m_opacityEffect, "opacity", this);
+    FLUENT_PERF_ANIMATION(m_opacityAnimation);
     m_opacityAnimation->setDuration(300);
     m_opacityAnimation->setEasingCurve(QEasingCurve::OutCubic);
 
@@ -208,6 +211,7 @@ void FluentModalWidget::updateTheme()
 
 void FluentModalWidget::updateStyles()
 {
+    FLUENT_PERF_SCOPE(StyleUpdate);
     QString modalStyle;
     QString primaryButtonStyle;
     QString secondaryButtonStyle;
@@ -475,6 +479,7 @@ void FluentModalWidget::leaveEvent(QEvent *event)
 
 void FluentModalWidget::paintEvent(QPaintEvent *event)
 {
+    FLUENT_PERF_SCOPE(Paint);
     QStyleOption opt;
     opt.initFrom(this);
     QPainter p(this);
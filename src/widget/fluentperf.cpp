@@ -0,0 +1,194 @@
+#include "fluentperf.h"
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QMutexLocker>
+#include <QVariantAnimation>
+
+namespace {
+
+void add(FluentPerf::Counter *counter, qint64 nsecs)
+{
+    ++counter->count;
+    counter->nsecs += nsecs;
+    counter->maxNsecs = qMax(counter->maxNsecs, nsecs);
+}
+
+QJsonObject counterObject(const FluentPerf::Counter &counter)
+{
+    QJsonObject object;
+    object.insert(QStringLiteral("count"), double(counter.count));
+    object.insert(QStringLiteral("totalMsecs"), counter.nsecs / 1e6);
+    object.insert(QStringLiteral("maxMsecs"), counter.maxNsecs / 1e6);
+    return object;
+}
+
+} // namespace
+
+FluentPerf::FluentPerf(QObject *parent)
+    : QObject(parent)
+{
+}
+
+FluentPerf *FluentPerf::instance()
+{
+    static FluentPerf perf;
+    return &perf;
+}
+
+bool FluentPerf::isEnabled()
+{
+#ifdef FLUENTWIDGET_PERF
+    return true;
+#else
+    return false;
+#endif
+}
+
+void FluentPerf::record(const QObject *widget, Operation operation, qint64 nsecs)
+{
+    if (!widget || operation < 0 || operation >= OperationCount) return;
+
+    FluentPerf *perf = instance();
+    QMutexLocker locker(&perf->m_mutex);
+
+    // A widget's counters go with it, so a later widget at the same address
+    // starts from zero
+    auto entry = perf->m_instances.find(widget);
+    if (entry == perf->m_instances.end()) {
+        entry = perf->m_instances.insert(widget, Counters());
+        connect(widget, &QObject::destroyed, perf, &FluentPerf::onInstanceDestroyed, Qt::DirectConnection);
+    }
+
+    add(&entry->operations[operation], nsecs);
+    add(&perf->m_total.operations[operation], nsecs);
+}
+
+void FluentPerf::watchAnimation(QVariantAnimation *animation)
+{
+    if (!animation) return;
+    connect(animation, &QVariantAnimation::valueChanged, instance(), &FluentPerf::onAnimationValueChanged,
+            Qt::DirectConnection);
+}
+
+FluentPerf::Counter FluentPerf::counter(const QObject *widget, Operation operation)
+{
+    if (operation < 0 || operation >= OperationCount) return Counter();
+
+    FluentPerf *perf = instance();
+    QMutexLocker locker(&perf->m_mutex);
+    const auto entry = perf->m_instances.constFind(widget);
+    return entry == perf->m_instances.constEnd() ? Counter() : entry->operations[operation];
+}
+
+FluentPerf::Counter FluentPerf::total(Operation operation)
+{
+    if (operation < 0 || operation >= OperationCount) return Counter();
+
+    FluentPerf *perf = instance();
+    QMutexLocker locker(&perf->m_mutex);
+    return perf->m_total.operations[operation];
+}
+
+QList<const QObject*> FluentPerf::instances()
+{
+    FluentPerf *perf = instance();
+    QMutexLocker locker(&perf->m_mutex);
+    return perf->m_instances.keys();
+}
+
+void FluentPerf::reset(const QObject *widget)
+{
+    FluentPerf *perf = instance();
+    QMutexLocker locker(&perf->m_mutex);
+    auto entry = perf->m_instances.find(widget);
+    if (entry != perf->m_instances.end()) {
+        *entry = Counters();
+    }
+}
+
+void FluentPerf::reset()
+{
+    // Widgets stay registered for their destroyed() connection
+    FluentPerf *perf = instance();
+    QMutexLocker locker(&perf->m_mutex);
+    for (Counters &counters : perf->m_instances) {
+        counters = Counters();
+    }
+    perf->m_total = Counters();
+}
+
+QByteArray FluentPerf::toJson(QJsonDocument::JsonFormat format)
+{
+    FluentPerf *perf = instance();
+    QMutexLocker locker(&perf->m_mutex);
+
+    QJsonObject total;
+    for (int i = 0; i < OperationCount; ++i) {
+        total.insert(QLatin1String(operationName(Operation(i))), counterObject(perf->m_total.operations[i]));
+    }
+
+    // Widgets still alive; names are read now, as they are usually set
+    // after the first paint or style update
+    QJsonArray instances;
+    for (auto entry = perf->m_instances.cbegin(); entry != perf->m_instances.cend(); ++entry) {
+        QJsonObject counters;
+        for (int i = 0; i < OperationCount; ++i) {
+            counters.insert(QLatin1String(operationName(Operation(i))), counterObject(entry->operations[i]));
+        }
+
+        QJsonObject object;
+        object.insert(QStringLiteral("class"), QLatin1String(entry.key()->metaObject()->className()));
+        object.insert(QStringLiteral("objectName"), entry.key()->objectName());
+        object.insert(QStringLiteral("counters"), counters);
+        instances.append(object);
+    }
+
+    QJsonObject root;
+    root.insert(QStringLiteral("enabled"), isEnabled());
+    root.insert(QStringLiteral("total"), total);
+    root.insert(QStringLiteral("instances"), instances);
+    return QJsonDocument(root).toJson(format);
+}
+
+const char *FluentPerf::operationName(Operation operation)
+{
+    switch (operation) {
+        case Paint:         return "paint";
+        case PlotRender:    return "plotRender";
+        case StyleUpdate:   return "styleUpdate";
+        case ChartUpdate:   return "chartUpdate";
+        case ModelLoad:     return "modelLoad";
+        case Pagination:    return "pagination";
+        case AnimationTick: return "animationTick";
+        case OperationCount: break;
+    }
+    return "";
+}
+
+void FluentPerf::onInstanceDestroyed(QObject *object)
+{
+    QMutexLocker locker(&m_mutex);
+    m_instances.remove(object);
+}
+
+void FluentPerf::onAnimationValueChanged()
+{
+    // The property is already set when valueChanged() is emitted, so a tick
+    // is counted but not timed
+    if (QObject *animation = sender()) {
+        record(animation->parent(), AnimationTick, 0);
+    }
+}
+
+FluentPerf::Scope::Scope(const QObject *widget, Operation operation)
+    : m_widget(widget)
+    , m_operation(operation)
+{
+    m_timer.start();
+}
+
+FluentPerf::Scope::~Scope()
+{
+    FluentPerf::record(m_widget, m_operation, m_timer.nsecsElapsed());
+}
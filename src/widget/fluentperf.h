@@ -0,0 +1,104 @@
+#ifndef FLUENTPERF_H
+#define FLUENTPERF_H
+
+#include <QObject>
+#include <QHash>
+#include <QMutex>
+#include <QElapsedTimer>
+#include <QJsonDocument>
+
+class QVariantAnimation;
+
+// Counts and times the costly operations of the Fluent widgets: paints,
+// graph plot renders, style updates, chart rebuilds, model loads,
+// pagination and animation ticks, per widget and in total.
+//
+// The widgets report through the FLUENT_PERF_* macros below, which only
+// expand to anything in builds with FLUENTWIDGET_PERF defined (CMake
+// -DFLUENTWIDGET_WITH_PERF=ON, qmake CONFIG+=fluentwidget_perf). The queries
+// exist in every build and return zeros when nothing is recorded. Totals
+// keep the counts of widgets that have since been destroyed.
+class FluentPerf : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Operation {
+        Paint,
+        PlotRender,         // a graph card's plot drawn into its cache
+        StyleUpdate,
+        ChartUpdate,
+        ModelLoad,
+        Pagination,
+        AnimationTick,
+        OperationCount
+    };
+
+    struct Counter {
+        qint64 count = 0;
+        qint64 nsecs = 0;       // summed over all counted operations
+        qint64 maxNsecs = 0;
+    };
+
+    // Whether the widgets were built to report
+    static bool isEnabled();
+
+    static void record(const QObject *widget, Operation operation, qint64 nsecs);
+
+    // Counts each value change of animation towards its parent widget
+    static void watchAnimation(QVariantAnimation *animation);
+
+    static Counter counter(const QObject *widget, Operation operation);
+    static Counter total(Operation operation);
+    static QList<const QObject*> instances();
+
+    // Clears the counters of one widget, or of every widget and the totals
+    static void reset(const QObject *widget);
+    static void reset();
+
+    // {"enabled", "total": {operation: counter}, "instances": [{"class",
+    // "objectName", "counters": {operation: counter}}]}, times in milliseconds
+    static QByteArray toJson(QJsonDocument::JsonFormat format = QJsonDocument::Indented);
+
+    static const char *operationName(Operation operation);
+
+    // Times the enclosing scope as one operation of widget
+    class Scope
+    {
+    public:
+        Scope(const QObject *widget, Operation operation);
+        ~Scope();
+
+    private:
+        const QObject *m_widget;
+        Operation m_operation;
+        QElapsedTimer m_timer;
+    };
+
+private slots:
+    void onInstanceDestroyed(QObject *object);
+    void onAnimationValueChanged();
+
+private:
+    explicit FluentPerf(QObject *parent = nullptr);
+    static FluentPerf *instance();
+
+    struct Counters {
+        Counter operations[OperationCount];
+    };
+
+    mutable QMutex m_mutex;
+    QHash<const QObject*, Counters> m_instances;
+    Counters m_total;
+};
+
+#ifdef FLUENTWIDGET_PERF
+#define FLUENT_PERF_SCOPE(operation) \
+    FluentPerf::Scope fluentPerfScope(this, FluentPerf::operation)
+#define FLUENT_PERF_ANIMATION(animation) FluentPerf::watchAnimation(animation)
+#else
+#define FLUENT_PERF_SCOPE(operation) do {} while (false)
+#define FLUENT_PERF_ANIMATION(animation) do {} while (false)
+#endif
+
+#endif // FLUENTPERF_H
@@ -1,4 +1,5 @@
 #include "fluentplaincardwidget.h"
+#include "fluentperf.h"
 #include <QApplication>
 #include <QPalette>
 #include <QDebug>
@@ -92,6 +93,7 @@ void FluentPlainCardWidget::setupHoverAnimation()
     }
 
     m_hoverAnimation = new QPropertyAnimation(this, "pos", this);
+    FLUENT_PERF_ANIMATION(m_hoverAnimation);
     m_hoverAnimation->setDuration(150);
     m_hoverAnimation->setEasingCurve(QEasingCurve::OutCubic);
 
@@ -101,6 +103,7 @@ void FluentPlainCardWidget::setupHoverAnimation()
 
 void FluentPlainCardWidget::updateStyles()
 {
+    FLUENT_PERF_SCOPE(StyleUpdate);
     QString cardStyle;
 
     // Determine colors based on theme
@@ -211,6 +214,7 @@ void FluentPlainCardWidget::onHoverAnimationFinished()
 
 void FluentPlainCardWidget::paintEvent(QPaintEvent *event)
 {
+    FLUENT_PERF_SCOPE(Paint);
     QStyleOption opt;
     opt.initFrom(this);
     QPainter p(this);
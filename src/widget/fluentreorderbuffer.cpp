@@ -0,0 +1,92 @@
+#include "fluentreorderbuffer.h"
+
+#include <algorithm>
+
+FluentReorderBuffer::FluentReorderBuffer(qint64 window, qint64 releasedTime)
+    : m_window(qMax(qint64(0), window))
+    , m_newest(releasedTime)
+    , m_released(releasedTime)
+    , m_lateCount(0)
+{
+}
+
+qint64 FluentReorderBuffer::window() const
+{
+    return m_window;
+}
+
+void FluentReorderBuffer::setWindow(qint64 msecs)
+{
+    m_window = qMax(qint64(0), msecs);
+}
+
+bool FluentReorderBuffer::insert(qint64 time, double value)
+{
+    if (time < m_released) {
+        ++m_lateCount;
+        return false;
+    }
+
+    // Nearly every sample is the newest one, so it goes to the back without
+    // a search; stragglers are placed after the samples of equal time
+    if (m_samples.isEmpty() || m_samples.constLast().time <= time) {
+        m_samples.append(Sample{time, value});
+    } else {
+        const auto position = std::upper_bound(m_samples.begin(), m_samples.end(), time,
+                                               [](qint64 t, const Sample &sample) { return t < sample.time; });
+        m_samples.insert(position - m_samples.begin(), Sample{time, value});
+    }
+
+    m_newest = qMax(m_newest, time);
+    return true;
+}
+
+QList<FluentReorderBuffer::Sample> FluentReorderBuffer::takeReady()
+{
+    // Computed without overflow for the initial, lowest possible time
+    const qint64 cutoff = m_newest < std::numeric_limits<qint64>::min() + m_window
+                              ? std::numeric_limits<qint64>::min()
+                              : m_newest - m_window;
+
+    qsizetype count = 0;
+    while (count < m_samples.size() && m_samples.at(count).time <= cutoff) {
+        ++count;
+    }
+    return take(count);
+}
+
+QList<FluentReorderBuffer::Sample> FluentReorderBuffer::takeAll()
+{
+    return take(m_samples.size());
+}
+
+bool FluentReorderBuffer::isEmpty() const
+{
+    return m_samples.isEmpty();
+}
+
+qsizetype FluentReorderBuffer::size() const
+{
+    return m_samples.size();
+}
+
+qint64 FluentReorderBuffer::lateCount() const
+{
+    return m_lateCount;
+}
+
+QList<FluentReorderBuffer::Sample> FluentReorderBuffer::take(qsizetype count)
+{
+    if (count <= 0) return QList<Sample>();
+
+    QList<Sample> ready;
+    if (count == m_samples.size()) {
+        ready.swap(m_samples);
+    } else {
+        ready = m_samples.mid(0, count);
+        m_samples.remove(0, count);
+    }
+
+    m_released = ready.constLast().time;
+    return ready;
+}
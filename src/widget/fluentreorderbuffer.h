@@ -0,0 +1,55 @@
+#ifndef FLUENTREORDERBUFFER_H
+#define FLUENTREORDERBUFFER_H
+
+#include <QList>
+#include <QtGlobal>
+
+#include <limits>
+
+// Holds timestamped samples that may arrive slightly out of order and
+// releases them sorted, so they can be appended to storage that only grows
+// at the end and stays searchable by time.
+//
+// A sample is released once it is at least `window` milliseconds older than
+// the newest sample seen, as nothing that may still arrive can precede it.
+// A sample older than one already released has missed its place; it is
+// counted and dropped.
+class FluentReorderBuffer
+{
+public:
+    struct Sample {
+        qint64 time;    // milliseconds since the epoch
+        double value;
+    };
+
+    explicit FluentReorderBuffer(qint64 window = 0,
+                                 qint64 releasedTime = std::numeric_limits<qint64>::min());
+
+    qint64 window() const;
+    void setWindow(qint64 msecs);
+
+    // Returns false for a sample that comes too late to be placed in order
+    bool insert(qint64 time, double value);
+
+    // Samples no later arrival can precede, oldest first
+    QList<Sample> takeReady();
+
+    // Everything held, oldest first; later samples must not be older than
+    // the last one returned
+    QList<Sample> takeAll();
+
+    bool isEmpty() const;
+    qsizetype size() const;
+    qint64 lateCount() const;
+
+private:
+    QList<Sample> take(qsizetype count);
+
+    QList<Sample> m_samples;    // by time; equal times keep their arrival order
+    qint64 m_window;
+    qint64 m_newest;
+    qint64 m_released;          // time of the last sample released
+    qint64 m_lateCount;
+};
+
+#endif // FLUENTREORDERBUFFER_H
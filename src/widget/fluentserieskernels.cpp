@@ -0,0 +1,355 @@
+#include "fluentserieskernels.h"
+
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <immintrin.h>
+#define FLUENT_KERNELS_SSE2
+#if defined(__GNUC__) && !defined(_MSC_VER)
+// Built for any x86-64 CPU; the AVX2 code is only run where it is supported
+#define FLUENT_KERNELS_AVX2
+#define FLUENT_KERNELS_AVX2_RUNTIME
+#define FLUENT_AVX2_TARGET __attribute__((target("avx2")))
+#elif defined(__AVX2__)
+#define FLUENT_KERNELS_AVX2
+#define FLUENT_AVX2_TARGET
+#endif
+#endif
+
+namespace {
+
+using Extents = FluentSeriesKernels::Extents;
+
+enum Level {
+    ScalarLevel,
+    Sse2Level,
+    Avx2Level
+};
+
+// The point kernels treat a QPointF as two packed doubles
+const bool kDoublePoints = sizeof(QPointF) == 2 * sizeof(double);
+
+const double kInfinity = std::numeric_limits<double>::infinity();
+
+// Set bits of a movemask result
+const int kBitCount[16] = {0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4};
+
+Level detectLevel()
+{
+#if defined(FLUENT_KERNELS_AVX2_RUNTIME)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") ? Avx2Level : Sse2Level;
+#elif defined(FLUENT_KERNELS_AVX2)
+    return Avx2Level;
+#elif defined(FLUENT_KERNELS_SSE2)
+    return Sse2Level;
+#else
+    return ScalarLevel;
+#endif
+}
+
+Level level()
+{
+    static const Level detected = detectLevel();
+    return detected;
+}
+
+// Scalar kernels, which also finish the tail the vector loops leave
+void extentsScalar(const double *x, const double *y, qsizetype from, qsizetype count,
+                   double lowX, double highX, Extents *extents)
+{
+    for (qsizetype i = from; i < count; ++i) {
+        if (!std::isfinite(x[i]) || !std::isfinite(y[i])) {
+            ++extents->nonFiniteCount;
+            continue;
+        }
+        if (x[i] < lowX || x[i] > highX) continue;
+
+        extents->minX = qMin(extents->minX, x[i]);
+        extents->maxX = qMax(extents->maxX, x[i]);
+        extents->minY = qMin(extents->minY, y[i]);
+        extents->maxY = qMax(extents->maxY, y[i]);
+        ++extents->finiteCount;
+    }
+}
+
+template <bool Baseline>
+void compactScalar(const QPointF *points, qsizetype from, qsizetype count, double baseline,
+                   QPointF *upper, qsizetype *upperCount, QPointF *lower, qsizetype *lowerCount)
+{
+    for (qsizetype i = from; i < count; ++i) {
+        const QPointF &point = points[i];
+        if (!std::isfinite(point.x())) continue;
+
+        if (Baseline) {
+            lower[(*lowerCount)++] = QPointF(point.x(), baseline);
+        }
+        if (std::isfinite(point.y())) {
+            upper[(*upperCount)++] = point;
+        }
+    }
+}
+
+#ifdef FLUENT_KERNELS_SSE2
+
+inline __m128d finiteMask(__m128d values)
+{
+    // v - v is 0 for finite values and NaN for infinities and NaN
+    return _mm_cmpeq_pd(_mm_sub_pd(values, values), _mm_setzero_pd());
+}
+
+inline __m128d select(__m128d mask, __m128d a, __m128d b)
+{
+    return _mm_or_pd(_mm_and_pd(mask, a), _mm_andnot_pd(mask, b));
+}
+
+inline double horizontalMin(__m128d values)
+{
+    return _mm_cvtsd_f64(_mm_min_sd(values, _mm_unpackhi_pd(values, values)));
+}
+
+inline double horizontalMax(__m128d values)
+{
+    return _mm_cvtsd_f64(_mm_max_sd(values, _mm_unpackhi_pd(values, values)));
+}
+
+// Each kernel returns how far it got; the scalar version does the rest
+qsizetype extentsSse2(const double *x, const double *y, qsizetype count,
+                      double lowX, double highX, Extents *extents)
+{
+    const __m128d low = _mm_set1_pd(lowX);
+    const __m128d high = _mm_set1_pd(highX);
+    const __m128d positive = _mm_set1_pd(kInfinity);
+    const __m128d negative = _mm_set1_pd(-kInfinity);
+
+    // Rejected lanes contribute infinities, which never win
+    __m128d minX = positive;
+    __m128d maxX = negative;
+    __m128d minY = positive;
+    __m128d maxY = negative;
+
+    qsizetype i = 0;
+    for (; i + 2 <= count; i += 2) {
+        const __m128d vx = _mm_loadu_pd(x + i);
+        const __m128d vy = _mm_loadu_pd(y + i);
+        const __m128d finite = _mm_and_pd(finiteMask(vx), finiteMask(vy));
+        const __m128d inside = _mm_and_pd(finite, _mm_and_pd(_mm_cmpge_pd(vx, low), _mm_cmple_pd(vx, high)));
+
+        minX = _mm_min_pd(minX, select(inside, vx, positive));
+        maxX = _mm_max_pd(maxX, select(inside, vx, negative));
+        minY = _mm_min_pd(minY, select(inside, vy, positive));
+        maxY = _mm_max_pd(maxY, select(inside, vy, negative));
+
+        extents->nonFiniteCount += 2 - kBitCount[_mm_movemask_pd(finite)];
+        extents->finiteCount += kBitCount[_mm_movemask_pd(inside)];
+    }
+
+    extents->minX = qMin(extents->minX, horizontalMin(minX));
+    extents->maxX = qMax(extents->maxX, horizontalMax(maxX));
+    extents->minY = qMin(extents->minY, horizontalMin(minY));
+    extents->maxY = qMax(extents->maxY, horizontalMax(maxY));
+    return i;
+}
+
+template <bool Baseline>
+qsizetype compactSse2(const QPointF *points, qsizetype count, double baseline,
+                      QPointF *upper, qsizetype *upperCount, QPointF *lower, qsizetype *lowerCount)
+{
+    // Every point is stored at the next free slot and the slot is only
+    // claimed when the point is kept, so the loop has no branches
+    const double *values = reinterpret_cast<const double *>(points);
+    const __m128d base = _mm_set1_pd(baseline);
+    qsizetype kept = *upperCount;
+    qsizetype based = *lowerCount;
+
+    for (qsizetype i = 0; i < count; ++i) {
+        const __m128d point = _mm_loadu_pd(values + 2 * i);
+        const int finite = _mm_movemask_pd(finiteMask(point));
+
+        _mm_storeu_pd(reinterpret_cast<double *>(upper + kept), point);
+        kept += finite == 3;
+        if (Baseline) {
+            _mm_storeu_pd(reinterpret_cast<double *>(lower + based), _mm_move_sd(base, point));
+            based += finite & 1;
+        }
+    }
+
+    *upperCount = kept;
+    *lowerCount = based;
+    return count;
+}
+
+#endif // FLUENT_KERNELS_SSE2
+
+#ifdef FLUENT_KERNELS_AVX2
+
+FLUENT_AVX2_TARGET inline __m256d finiteMask256(__m256d values)
+{
+    return _mm256_cmp_pd(_mm256_sub_pd(values, values), _mm256_setzero_pd(), _CMP_EQ_OQ);
+}
+
+FLUENT_AVX2_TARGET inline double horizontalMin256(__m256d values)
+{
+    return horizontalMin(_mm_min_pd(_mm256_castpd256_pd128(values), _mm256_extractf128_pd(values, 1)));
+}
+
+FLUENT_AVX2_TARGET inline double horizontalMax256(__m256d values)
+{
+    return horizontalMax(_mm_max_pd(_mm256_castpd256_pd128(values), _mm256_extractf128_pd(values, 1)));
+}
+
+FLUENT_AVX2_TARGET qsizetype extentsAvx2(const double *x, const double *y, qsizetype count,
+                                         double lowX, double highX, Extents *extents)
+{
+    const __m256d low = _mm256_set1_pd(lowX);
+    const __m256d high = _mm256_set1_pd(highX);
+    const __m256d positive = _mm256_set1_pd(kInfinity);
+    const __m256d negative = _mm256_set1_pd(-kInfinity);
+
+    __m256d minX = positive;
+    __m256d maxX = negative;
+    __m256d minY = positive;
+    __m256d maxY = negative;
+
+    qsizetype i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m256d vx = _mm256_loadu_pd(x + i);
+        const __m256d vy = _mm256_loadu_pd(y + i);
+        const __m256d finite = _mm256_and_pd(finiteMask256(vx), finiteMask256(vy));
+        const __m256d inside = _mm256_and_pd(finite, _mm256_and_pd(_mm256_cmp_pd(vx, low, _CMP_GE_OQ),
+                                                                   _mm256_cmp_pd(vx, high, _CMP_LE_OQ)));
+
+        minX = _mm256_min_pd(minX, _mm256_blendv_pd(positive, vx, inside));
+        maxX = _mm256_max_pd(maxX, _mm256_blendv_pd(negative, vx, inside));
+        minY = _mm256_min_pd(minY, _mm256_blendv_pd(positive, vy, inside));
+        maxY = _mm256_max_pd(maxY, _mm256_blendv_pd(negative, vy, inside));
+
+        extents->nonFiniteCount += 4 - kBitCount[_mm256_movemask_pd(finite)];
+        extents->finiteCount += kBitCount[_mm256_movemask_pd(inside)];
+    }
+
+    extents->minX = qMin(extents->minX, horizontalMin256(minX));
+    extents->maxX = qMax(extents->maxX, horizontalMax256(maxX));
+    extents->minY = qMin(extents->minY, horizontalMin256(minY));
+    extents->maxY = qMax(extents->maxY, horizontalMax256(maxY));
+    return i;
+}
+
+template <bool Baseline>
+FLUENT_AVX2_TARGET qsizetype compactAvx2(const QPointF *points, qsizetype count, double baseline,
+                                         QPointF *upper, qsizetype *upperCount,
+                                         QPointF *lower, qsizetype *lowerCount)
+{
+    // Two points per register: x0 y0 x1 y1
+    const double *values = reinterpret_cast<const double *>(points);
+    const __m256d base = _mm256_set1_pd(baseline);
+    qsizetype kept = *upperCount;
+    qsizetype based = *lowerCount;
+
+    qsizetype i = 0;
+    for (; i + 2 <= count; i += 2) {
+        const __m256d pair = _mm256_loadu_pd(values + 2 * i);
+        const int finite = _mm256_movemask_pd(finiteMask256(pair));
+
+        _mm_storeu_pd(reinterpret_cast<double *>(upper + kept), _mm256_castpd256_pd128(pair));
+        kept += (finite & 0x3) == 0x3;
+        _mm_storeu_pd(reinterpret_cast<double *>(upper + kept), _mm256_extractf128_pd(pair, 1));
+        kept += (finite & 0xc) == 0xc;
+
+        if (Baseline) {
+            const __m256d baselinePair = _mm256_blend_pd(pair, base, 0xa);
+            _mm_storeu_pd(reinterpret_cast<double *>(lower + based), _mm256_castpd256_pd128(baselinePair));
+            based += finite & 0x1;
+            _mm_storeu_pd(reinterpret_cast<double *>(lower + based), _mm256_extractf128_pd(baselinePair, 1));
+            based += (finite >> 2) & 0x1;
+        }
+    }
+
+    *upperCount = kept;
+    *lowerCount = based;
+    return i;
+}
+
+#endif // FLUENT_KERNELS_AVX2
+
+template <bool Baseline>
+void compact(const QPointF *points, qsizetype count, double baseline,
+             QPointF *upper, qsizetype *upperCount, QPointF *lower, qsizetype *lowerCount)
+{
+    *upperCount = 0;
+    *lowerCount = 0;
+
+    qsizetype done = 0;
+    if (kDoublePoints) {
+        switch (level()) {
+#ifdef FLUENT_KERNELS_AVX2
+            case Avx2Level:
+                done = compactAvx2<Baseline>(points, count, baseline, upper, upperCount, lower, lowerCount);
+                break;
+#endif
+#ifdef FLUENT_KERNELS_SSE2
+            case Sse2Level:
+                done = compactSse2<Baseline>(points, count, baseline, upper, upperCount, lower, lowerCount);
+                break;
+#endif
+            default:
+                break;
+        }
+    }
+    compactScalar<Baseline>(points, done, count, baseline, upper, upperCount, lower, lowerCount);
+}
+
+} // namespace
+
+FluentSeriesKernels::Extents FluentSeriesKernels::extents(const double *x, const double *y, qsizetype count,
+                                                          double lowX, double highX)
+{
+    Extents result = {kInfinity, -kInfinity, kInfinity, -kInfinity, 0, 0};
+    if (count <= 0) return result;
+
+    qsizetype done = 0;
+    switch (level()) {
+#ifdef FLUENT_KERNELS_AVX2
+        case Avx2Level:
+            done = extentsAvx2(x, y, count, lowX, highX, &result);
+            break;
+#endif
+#ifdef FLUENT_KERNELS_SSE2
+        case Sse2Level:
+            done = extentsSse2(x, y, count, lowX, highX, &result);
+            break;
+#endif
+        default:
+            break;
+    }
+    extentsScalar(x, y, done, count, lowX, highX, &result);
+    return result;
+}
+
+qsizetype FluentSeriesKernels::compactFinite(const QPointF *points, qsizetype count, QPointF *finite)
+{
+    qsizetype finiteCount = 0;
+    qsizetype unused = 0;
+    compact<false>(points, qMax(count, qsizetype(0)), 0.0, finite, &finiteCount, nullptr, &unused);
+    return finiteCount;
+}
+
+void FluentSeriesKernels::areaBoundaries(const QPointF *points, qsizetype count, double baseline,
+                                         QPointF *upper, qsizetype *upperCount,
+                                         QPointF *lower, qsizetype *lowerCount)
+{
+    compact<true>(points, qMax(count, qsizetype(0)), baseline, upper, upperCount, lower, lowerCount);
+}
+
+const char *FluentSeriesKernels::instructionSet()
+{
+    switch (level()) {
+        case Avx2Level:
+            return "AVX2";
+        case Sse2Level:
+            return "SSE2";
+        case ScalarLevel:
+            break;
+    }
+    return "scalar";
+}
@@ -0,0 +1,46 @@
+#ifndef FLUENTSERIESKERNELS_H
+#define FLUENTSERIESKERNELS_H
+
+#include <QPointF>
+
+#include <limits>
+
+// Single-pass scans over series data used while a chart is prepared. Each
+// kernel has SSE2 and AVX2 implementations next to a scalar fallback; the
+// widest one the CPU supports is chosen on first use.
+class FluentSeriesKernels
+{
+public:
+    struct Extents {
+        double minX;
+        double maxX;
+        double minY;
+        double maxY;
+        qsizetype finiteCount;      // points the ranges were taken from
+        qsizetype nonFiniteCount;   // points with a non-finite x or y
+
+        bool isValid() const { return finiteCount > 0; }
+    };
+
+    // Ranges of the points with finite x and y whose x lies within
+    // [lowX, highX]. Non-finite points are counted wherever they lie.
+    static Extents extents(const double *x, const double *y, qsizetype count,
+                           double lowX = -std::numeric_limits<double>::infinity(),
+                           double highX = std::numeric_limits<double>::infinity());
+
+    // Copies the points with finite x and y to finite, which must hold
+    // count points. Returns the number of points copied.
+    static qsizetype compactFinite(const QPointF *points, qsizetype count, QPointF *finite);
+
+    // Both boundaries of an area series in one pass: the points with finite
+    // x and y go to upper, and (x, baseline) for every point with a finite x
+    // to lower. Both outputs must hold count points.
+    static void areaBoundaries(const QPointF *points, qsizetype count, double baseline,
+                               QPointF *upper, qsizetype *upperCount,
+                               QPointF *lower, qsizetype *lowerCount);
+
+    // Implementation in use: "AVX2", "SSE2" or "scalar"
+    static const char *instructionSet();
+};
+
+#endif // FLUENTSERIESKERNELS_H
@@ -0,0 +1,159 @@
+#include "fluentseriesoverlay.h"
+
+#include <algorithm>
+#include <cmath>
+
+FluentSeriesOverlay::FluentSeriesOverlay()
+    : m_window(1)
+    , m_alpha(1.0)
+    , m_bandWidth(0.0)
+    , m_ringHead(0)
+    , m_ringCount(0)
+    , m_shift(0.0)
+    , m_sum(0.0)
+    , m_sumSquares(0.0)
+    , m_sinceResum(0)
+    , m_ewma(0.0)
+    , m_index(0)
+{
+}
+
+void FluentSeriesOverlay::reset(int window, double alpha, double bandWidth)
+{
+    m_window = qMax(1, window);
+    m_alpha = qBound(0.0, alpha, 1.0);
+    m_bandWidth = qMax(0.0, bandWidth);
+
+    m_ring = QList<double>(m_window, 0.0);
+    m_ringHead = 0;
+    m_ringCount = 0;
+    m_shift = 0.0;
+    m_sum = 0.0;
+    m_sumSquares = 0.0;
+    m_sinceResum = 0;
+    m_ewma = 0.0;
+    m_index = 0;
+    m_minQueue.clear();
+    m_maxQueue.clear();
+
+    m_x.clear();
+    for (QList<double> &values : m_values) {
+        values.clear();
+    }
+}
+
+qsizetype FluentSeriesOverlay::append(const double *x, const double *y, qsizetype count)
+{
+    const qsizetype before = m_x.size();
+    for (qsizetype i = 0; i < count; ++i) {
+        if (std::isfinite(x[i]) && std::isfinite(y[i])) {
+            addValue(x[i], y[i]);
+        }
+    }
+    return m_x.size() - before;
+}
+
+qsizetype FluentSeriesOverlay::removeBefore(double minX)
+{
+    // Outputs are ordered by x, so the stale ones are a prefix
+    const qsizetype count = std::lower_bound(m_x.cbegin(), m_x.cend(), minX) - m_x.cbegin();
+    if (count > 0) {
+        m_x.remove(0, count);
+        for (QList<double> &values : m_values) {
+            values.remove(0, count);
+        }
+    }
+    return count;
+}
+
+qsizetype FluentSeriesOverlay::size() const
+{
+    return m_x.size();
+}
+
+FluentSpan<double> FluentSeriesOverlay::xValues() const
+{
+    return FluentSpan<double>(m_x.constData(), m_x.size());
+}
+
+FluentSpan<double> FluentSeriesOverlay::values(Statistic statistic) const
+{
+    const QList<double> &values = m_values[statistic];
+    return FluentSpan<double>(values.constData(), values.size());
+}
+
+void FluentSeriesOverlay::addValue(double x, double y)
+{
+    // The first value is the shift until the next re-sum picks another
+    if (m_ringCount == 0) {
+        m_shift = y;
+    }
+
+    // Slide the window: the value leaving it is the one the ring overwrites
+    if (m_ringCount == m_window) {
+        const double leaving = m_ring.at(m_ringHead) - m_shift;
+        m_sum -= leaving;
+        m_sumSquares -= leaving * leaving;
+    } else {
+        ++m_ringCount;
+    }
+    m_ring[m_ringHead] = y;
+    m_ringHead = (m_ringHead + 1) % m_window;
+    const double shifted = y - m_shift;
+    m_sum += shifted;
+    m_sumSquares += shifted * shifted;
+
+    if (++m_sinceResum >= m_window) {
+        resum();
+    }
+
+    m_ewma = m_index == 0 ? y : m_alpha * y + (1.0 - m_alpha) * m_ewma;
+
+    // Candidates the new value beats can never be the extreme again; the
+    // front leaves once it falls out of the window
+    const qint64 oldest = m_index - m_window + 1;
+    while (!m_minQueue.empty() && m_minQueue.back().value >= y) {
+        m_minQueue.pop_back();
+    }
+    m_minQueue.push_back(Candidate{m_index, y});
+    if (m_minQueue.front().index < oldest) {
+        m_minQueue.pop_front();
+    }
+
+    while (!m_maxQueue.empty() && m_maxQueue.back().value <= y) {
+        m_maxQueue.pop_back();
+    }
+    m_maxQueue.push_back(Candidate{m_index, y});
+    if (m_maxQueue.front().index < oldest) {
+        m_maxQueue.pop_front();
+    }
+    ++m_index;
+
+    const double shiftedMean = m_sum / m_ringCount;
+    const double mean = m_shift + shiftedMean;
+    const double variance = qMax(0.0, m_sumSquares / m_ringCount - shiftedMean * shiftedMean);
+    const double deviation = m_bandWidth * std::sqrt(variance);
+
+    m_x.append(x);
+    m_values[MovingAverage].append(mean);
+    m_values[Ewma].append(m_ewma);
+    m_values[WindowMin].append(m_minQueue.front().value);
+    m_values[WindowMax].append(m_maxQueue.front().value);
+    m_values[LowerBand].append(mean - deviation);
+    m_values[UpperBand].append(mean + deviation);
+}
+
+void FluentSeriesOverlay::resum()
+{
+    // O(window) once every window points keeps append() O(1) amortised.
+    // The shift moves to the newest value, so it follows drifting data
+    m_shift = m_ring.at((m_ringHead + m_window - 1) % m_window);
+    m_sum = 0.0;
+    m_sumSquares = 0.0;
+    for (qsizetype i = 0; i < m_ringCount; ++i) {
+        const double value = m_ring.at(i) - m_shift;
+        m_sum += value;
+        m_sumSquares += value * value;
+    }
+    m_sinceResum = 0;
+}
@@ -0,0 +1,83 @@
+#ifndef FLUENTSERIESOVERLAY_H
+#define FLUENTSERIESOVERLAY_H
+
+#include <QList>
+#include <QPointF>
+
+#include <deque>
+
+#include "fluentseriestable.h"
+
+// Running statistics over one series, one output point per finite input
+// point, each appended in O(1):
+//
+//  - moving average and mean +/- k standard deviations over the last
+//    `window` points, from running sums of a ring buffer (re-summed once per
+//    window so rounding errors cannot build up). The sums are of the
+//    values less a shift taken from the window, so a large common offset
+//    does not cancel the variance away
+//  - exponentially weighted moving average with smoothing factor alpha
+//  - minimum and maximum over the last `window` points, from monotonic
+//    deques that only ever hold candidates still able to become the extreme
+//
+// Inputs are expected in non-decreasing x, as streamed series are; outputs
+// left of the series window are dropped with removeBefore().
+class FluentSeriesOverlay
+{
+public:
+    enum Statistic {
+        MovingAverage,
+        Ewma,
+        WindowMin,
+        WindowMax,
+        LowerBand,
+        UpperBand,
+        StatisticCount
+    };
+
+    FluentSeriesOverlay();
+
+    // Drops all state and outputs; statistics restart from the next point
+    void reset(int window, double alpha, double bandWidth);
+
+    // Returns the number of output points added (non-finite inputs add none)
+    qsizetype append(const double *x, const double *y, qsizetype count);
+
+    // Drops the outputs at x below minX; returns how many were dropped
+    qsizetype removeBefore(double minX);
+
+    qsizetype size() const;
+    FluentSpan<double> xValues() const;
+    FluentSpan<double> values(Statistic statistic) const;
+
+private:
+    struct Candidate {
+        qint64 index;
+        double value;
+    };
+
+    void addValue(double x, double y);
+    void resum();
+
+    int m_window;
+    double m_alpha;
+    double m_bandWidth;
+
+    // Window state: the last m_window finite values as a ring
+    QList<double> m_ring;
+    qsizetype m_ringHead;
+    qsizetype m_ringCount;
+    double m_shift;         // subtracted from every value in the sums
+    double m_sum;
+    double m_sumSquares;
+    qsizetype m_sinceResum;
+    double m_ewma;
+    qint64 m_index;
+    std::deque<Candidate> m_minQueue;   // increasing values, oldest first
+    std::deque<Candidate> m_maxQueue;   // decreasing values, oldest first
+
+    QList<double> m_x;
+    QList<double> m_values[StatisticCount];
+};
+
+#endif // FLUENTSERIESOVERLAY_H
@@ -0,0 +1,134 @@
+#include "fluentseriesstore.h"
+
+FluentSeriesStore::FluentSeriesStore(QObject *parent)
+    : QObject(parent)
+    , m_indexedCategories(0)
+    , m_retentionCount(0)
+    , m_retentionSpan(0.0)
+{
+}
+
+FluentSeriesTable &FluentSeriesStore::table()
+{
+    return m_table;
+}
+
+const FluentSeriesTable &FluentSeriesStore::table() const
+{
+    return m_table;
+}
+
+QStringList &FluentSeriesStore::categories()
+{
+    return m_categories;
+}
+
+const QStringList &FluentSeriesStore::categories() const
+{
+    return m_categories;
+}
+
+qsizetype FluentSeriesStore::internCategory(const QString &category)
+{
+    // Writers may append to the list directly; a shorter list means it was
+    // replaced without a reset, so the hash starts over
+    if (m_categories.size() < m_indexedCategories) {
+        m_categoryIndex.clear();
+        m_indexedCategories = 0;
+    }
+    for (; m_indexedCategories < m_categories.size(); ++m_indexedCategories) {
+        const QString &name = m_categories.at(m_indexedCategories);
+        if (!m_categoryIndex.contains(name)) {
+            m_categoryIndex.insert(name, m_indexedCategories);
+        }
+    }
+
+    const auto found = m_categoryIndex.constFind(category);
+    if (found != m_categoryIndex.constEnd()) return found.value();
+
+    m_categories.append(category);
+    m_categoryIndex.insert(category, m_indexedCategories);
+    return m_indexedCategories++;
+}
+
+int FluentSeriesStore::retentionCount() const
+{
+    return m_retentionCount;
+}
+
+void FluentSeriesStore::setRetentionCount(int count)
+{
+    m_retentionCount = qMax(0, count);
+
+    for (int id = 0; id < m_table.seriesCount(); ++id) {
+        if (m_retentionCount > 0) {
+            m_table.reserve(id, 2 * m_retentionCount);
+        }
+        if (applyRetention(id) > 0) {
+            notifySeriesChanged(id);
+        }
+    }
+}
+
+double FluentSeriesStore::retentionSpan() const
+{
+    return m_retentionSpan;
+}
+
+void FluentSeriesStore::setRetentionSpan(double span)
+{
+    m_retentionSpan = qMax(0.0, span);
+
+    for (int id = 0; id < m_table.seriesCount(); ++id) {
+        if (applyRetention(id) > 0) {
+            notifySeriesChanged(id);
+        }
+    }
+}
+
+qsizetype FluentSeriesStore::applyRetention(int id)
+{
+    const FluentSpan<double> x = m_table.xValues(id);
+    qsizetype excess = 0;
+
+    if (m_retentionCount > 0 && x.size() > m_retentionCount) {
+        excess = x.size() - m_retentionCount;
+    }
+
+    // Span retention assumes streamed x values are non-decreasing
+    if (m_retentionSpan > 0.0 && !x.isEmpty()) {
+        const double minX = x.last() - m_retentionSpan;
+        while (excess < x.size() - 1 && x[excess] < minX) {
+            ++excess;
+        }
+    }
+
+    if (excess > 0) {
+        m_table.removeFirst(id, excess);
+    }
+
+    return excess;
+}
+
+FluentSeriesTable FluentSeriesStore::snapshot() const
+{
+    return m_table;
+}
+
+void FluentSeriesStore::notifySeriesAppended(int id, qsizetype appended, qsizetype removed)
+{
+    emit seriesAppended(id, appended, removed);
+}
+
+void FluentSeriesStore::notifySeriesChanged(int id)
+{
+    emit seriesChanged(id);
+}
+
+void FluentSeriesStore::notifyDataReset()
+{
+    // The categories may have been rewritten in place
+    m_categoryIndex.clear();
+    m_indexedCategories = 0;
+    emit dataReset();
+}
@@ -0,0 +1,76 @@
+#ifndef FLUENTSERIESSTORE_H
+#define FLUENTSERIESSTORE_H
+
+#include <QObject>
+#include <QHash>
+#include <QStringList>
+
+#include "fluentseriestable.h"
+
+// Series data shown by one or more graph cards (see
+// FluentGraphCardWidget::setSeriesStore()). The store holds the only copy of
+// the columns. Whoever feeds it changes table() and categories() in place and
+// then reports the change once; every card showing the store updates from
+// that single notification.
+//
+// Columns are implicitly shared, so snapshot() is a copy-on-write view that
+// costs nothing to take: a column is only copied if the store writes to it
+// while a snapshot still refers to it. Snapshots may be handed to other
+// threads, for instance to FluentGraphCardWidget::renderImage().
+class FluentSeriesStore : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit FluentSeriesStore(QObject *parent = nullptr);
+
+    FluentSeriesTable &table();
+    const FluentSeriesTable &table() const;
+
+    // Labels of bar and pie chart categories
+    QStringList &categories();
+    const QStringList &categories() const;
+
+    // Index of category in categories(), appended first if it is new. A
+    // hash follows the list as it grows, so a lookup costs O(1) instead of
+    // a scan; notifyDataReset() drops it along with any other change
+    qsizetype internCategory(const QString &category);
+
+    // Streaming retention (0 = unlimited). It belongs to the data, so every
+    // card showing the store sees the same history; changing it trims each
+    // series right away and reports the ones that lost points
+    int retentionCount() const;
+    void setRetentionCount(int count);
+
+    double retentionSpan() const;
+    void setRetentionSpan(double span);
+
+    // Drops the points of series id that fall outside the retention from its
+    // front and returns how many; writers call it before reporting appends
+    qsizetype applyRetention(int id);
+
+    FluentSeriesTable snapshot() const;
+
+    // Called by the writer once the data has been changed
+    void notifySeriesAppended(int id, qsizetype appended, qsizetype removed);
+    void notifySeriesChanged(int id);
+    void notifyDataReset();
+
+signals:
+    // Points were appended to a series and removed from its front
+    void seriesAppended(int id, qsizetype appended, qsizetype removed);
+    // Values of a series were rewritten in place
+    void seriesChanged(int id);
+    // Anything else: series added, replaced or cleared, categories changed
+    void dataReset();
+
+private:
+    FluentSeriesTable m_table;
+    QStringList m_categories;
+    QHash<QString, qsizetype> m_categoryIndex;  // first index of each category
+    qsizetype m_indexedCategories;              // leading categories in the hash
+    int m_retentionCount;
+    double m_retentionSpan;
+};
+
+#endif // FLUENTSERIESSTORE_H
@@ -0,0 +1,249 @@
+#include "fluentseriestable.h"
+#include "fluentmappedseriesfile.h"
+
+FluentSeriesTable::FluentSeriesTable()
+{
+}
+
+bool FluentSeriesTable::isEmpty() const
+{
+    return m_series.isEmpty();
+}
+
+int FluentSeriesTable::seriesCount() const
+{
+    return int(m_series.size());
+}
+
+void FluentSeriesTable::clear()
+{
+    m_series.clear();
+    m_ids.clear();
+}
+
+int FluentSeriesTable::addSeries(const QString &name)
+{
+    auto it = m_ids.constFind(name);
+    if (it != m_ids.constEnd()) {
+        return it.value();
+    }
+
+    const int id = int(m_series.size());
+    m_series.append(Series{name, QList<double>(), QList<double>(),
+                           FluentSpan<double>(), FluentSpan<double>(), QSharedPointer<FluentMappedSeriesFile>()});
+    m_ids.insert(name, id);
+    return id;
+}
+
+int FluentSeriesTable::seriesId(const QString &name) const
+{
+    return m_ids.value(name, -1);
+}
+
+bool FluentSeriesTable::contains(const QString &name) const
+{
+    return m_ids.contains(name);
+}
+
+QString FluentSeriesTable::seriesName(int id) const
+{
+    return id >= 0 && id < m_series.size() ? m_series.at(id).name : QString();
+}
+
+QStringList FluentSeriesTable::seriesNames() const
+{
+    QStringList names;
+    names.reserve(m_series.size());
+    for (const Series &series : m_series) {
+        names.append(series.name);
+    }
+    return names;
+}
+
+qsizetype FluentSeriesTable::size(int id) const
+{
+    return yValues(id).size();
+}
+
+FluentSpan<double> FluentSeriesTable::xValues(int id) const
+{
+    if (id < 0 || id >= m_series.size()) return FluentSpan<double>();
+
+    const Series &series = m_series.at(id);
+    return series.file ? series.mappedX : FluentSpan<double>(series.x);
+}
+
+FluentSpan<double> FluentSeriesTable::yValues(int id) const
+{
+    if (id < 0 || id >= m_series.size()) return FluentSpan<double>();
+
+    const Series &series = m_series.at(id);
+    return series.file ? series.mappedY : FluentSpan<double>(series.y);
+}
+
+QPointF FluentSeriesTable::point(int id, qsizetype index) const
+{
+    Q_ASSERT(index >= 0 && index < size(id));
+    return QPointF(xValues(id)[index], yValues(id)[index]);
+}
+
+QList<QPointF> FluentSeriesTable::points(int id, qsizetype first, qsizetype count) const
+{
+    QList<QPointF> result;
+    if (id < 0 || id >= m_series.size()) return result;
+
+    const FluentSpan<double> x = xValues(id);
+    const FluentSpan<double> y = yValues(id);
+    first = qBound(qsizetype(0), first, y.size());
+    const qsizetype last = count < 0 ? y.size() : qMin(first + count, y.size());
+
+    result.reserve(last - first);
+    for (qsizetype i = first; i < last; ++i) {
+        result.append(QPointF(x[i], y[i]));
+    }
+    return result;
+}
+
+void FluentSeriesTable::setPoints(int id, const QList<QPointF> &points)
+{
+    Series &series = m_series[id];
+    series.file.reset();
+    series.x.clear();
+    series.y.clear();
+    series.x.reserve(points.size());
+    series.y.reserve(points.size());
+    appendPoints(id, points.constData(), points.size());
+}
+
+void FluentSeriesTable::setColumns(int id, const QList<double> &x, const QList<double> &y)
+{
+    Q_ASSERT(x.size() == y.size());
+
+    Series &series = m_series[id];
+    series.file.reset();
+    series.x = x;
+    series.y = y;
+}
+
+void FluentSeriesTable::setMappedColumns(int id, FluentSpan<double> x, FluentSpan<double> y,
+                                         const QSharedPointer<FluentMappedSeriesFile> &file)
+{
+    Q_ASSERT(x.size() == y.size());
+    Q_ASSERT(file);
+
+    // The file keeps the mapping alive for as long as a series reads from it
+    Series &series = m_series[id];
+    series.x.clear();
+    series.y.clear();
+    series.mappedX = x;
+    series.mappedY = y;
+    series.file = file;
+}
+
+bool FluentSeriesTable::isMapped(int id) const
+{
+    return id >= 0 && id < m_series.size() && m_series.at(id).file;
+}
+
+void FluentSeriesTable::setYValue(int id, qsizetype index, double y)
+{
+    detach(m_series[id]);
+    m_series[id].y[index] = y;
+}
+
+void FluentSeriesTable::appendPoint(int id, double x, double y)
+{
+    Series &series = m_series[id];
+    detach(series);
+    series.x.append(x);
+    series.y.append(y);
+}
+
+void FluentSeriesTable::appendPoints(int id, const QPointF *points, qsizetype count)
+{
+    Series &series = m_series[id];
+    detach(series);
+    for (qsizetype i = 0; i < count; ++i) {
+        series.x.append(points[i].x());
+        series.y.append(points[i].y());
+    }
+}
+
+void FluentSeriesTable::appendYValues(int id, const double *y, qsizetype count)
+{
+    detach(m_series[id]);
+    QList<double> &column = m_series[id].y;
+    for (qsizetype i = 0; i < count; ++i) {
+        column.append(y[i]);
+    }
+}
+
+void FluentSeriesTable::appendSharedXValues(const QList<int> &ids, const double *x, qsizetype count)
+{
+    if (ids.isEmpty()) return;
+
+    for (int id : ids) {
+        detach(m_series[id]);
+    }
+
+    // Release every reference to the shared column but one, so it is
+    // appended in place; series with a column of their own append to it
+    QList<double> column = m_series.at(ids.first()).x;
+    QList<int> sharing;
+    for (int id : ids) {
+        QList<double> &own = m_series[id].x;
+        if (own.constData() == column.constData()) {
+            sharing.append(id);
+            own = QList<double>();
+        } else {
+            for (qsizetype i = 0; i < count; ++i) {
+                own.append(x[i]);
+            }
+        }
+    }
+
+    for (qsizetype i = 0; i < count; ++i) {
+        column.append(x[i]);
+    }
+
+    for (int id : sharing) {
+        m_series[id].x = column;
+    }
+}
+
+void FluentSeriesTable::removeFirst(int id, qsizetype count)
+{
+    Series &series = m_series[id];
+    count = qMin(count, size(id));
+    if (count <= 0) return;
+
+    // A mapped window just starts later
+    if (series.file) {
+        series.mappedX = series.mappedX.subspan(count, series.mappedX.size() - count);
+        series.mappedY = series.mappedY.subspan(count, series.mappedY.size() - count);
+        return;
+    }
+
+    series.x.remove(0, count);
+    series.y.remove(0, count);
+}
+
+void FluentSeriesTable::reserve(int id, qsizetype capacity)
+{
+    Series &series = m_series[id];
+    detach(series);
+    series.x.reserve(capacity);
+    series.y.reserve(capacity);
+}
+
+void FluentSeriesTable::detach(Series &series)
+{
+    if (!series.file) return;
+
+    // Copy the mapped window so the series can be written
+    series.x = QList<double>(series.mappedX.begin(), series.mappedX.end());
+    series.y = QList<double>(series.mappedY.begin(), series.mappedY.end());
+    series.mappedX = FluentSpan<double>();
+    series.mappedY = FluentSpan<double>();
+    series.file.reset();
+}
@@ -0,0 +1,110 @@
+#ifndef FLUENTSERIESTABLE_H
+#define FLUENTSERIESTABLE_H
+
+#include <QList>
+#include <QHash>
+#include <QPointF>
+#include <QSharedPointer>
+#include <QString>
+
+class FluentMappedSeriesFile;
+
+// Read-only view of a contiguous column. Stands in for std::span while the
+// project is built as C++17; it is only valid until the column is modified.
+template <typename T>
+class FluentSpan
+{
+public:
+    FluentSpan() : m_data(nullptr), m_size(0) {}
+    FluentSpan(const T *data, qsizetype size) : m_data(data), m_size(size) {}
+    FluentSpan(const QList<T> &list) : m_data(list.constData()), m_size(list.size()) {}
+
+    const T *data() const { return m_data; }
+    qsizetype size() const { return m_size; }
+    bool isEmpty() const { return m_size == 0; }
+
+    const T &operator[](qsizetype index) const { return m_data[index]; }
+    const T &first() const { return m_data[0]; }
+    const T &last() const { return m_data[m_size - 1]; }
+
+    const T *begin() const { return m_data; }
+    const T *end() const { return m_data + m_size; }
+
+    FluentSpan subspan(qsizetype offset, qsizetype count) const { return FluentSpan(m_data + offset, count); }
+
+private:
+    const T *m_data;
+    qsizetype m_size;
+};
+
+// Columnar storage for the series of a graph card. Every series keeps its x
+// and y values in two contiguous columns, so passes that only need y (bars,
+// pies, envelopes, extents) stream through plain doubles.
+//
+// Series are numbered in insertion order and ids stay valid until clear().
+// X columns are implicitly shared: series loaded against the same x values
+// (all y columns of a model, for instance) hold a single copy of them.
+//
+// A series can also read its columns from a memory-mapped file. Mapped
+// columns are used in place; dropping points from the front only narrows
+// the window, and any other write copies the window into the table first.
+class FluentSeriesTable
+{
+public:
+    FluentSeriesTable();
+
+    bool isEmpty() const;
+    int seriesCount() const;
+    void clear();
+
+    // Series lookup; addSeries() returns the existing id for a known name
+    int addSeries(const QString &name);
+    int seriesId(const QString &name) const;
+    bool contains(const QString &name) const;
+    QString seriesName(int id) const;
+    QStringList seriesNames() const;
+
+    // Column access
+    qsizetype size(int id) const;
+    FluentSpan<double> xValues(int id) const;
+    FluentSpan<double> yValues(int id) const;
+    QPointF point(int id, qsizetype index) const;
+    QList<QPointF> points(int id, qsizetype first = 0, qsizetype count = -1) const;
+
+    // Writing
+    void setPoints(int id, const QList<QPointF> &points);
+    void setColumns(int id, const QList<double> &x, const QList<double> &y);
+    void setMappedColumns(int id, FluentSpan<double> x, FluentSpan<double> y,
+                          const QSharedPointer<FluentMappedSeriesFile> &file);
+    bool isMapped(int id) const;
+    void setYValue(int id, qsizetype index, double y);
+    void appendPoint(int id, double x, double y);
+    void appendPoints(int id, const QPointF *points, qsizetype count);
+    void appendYValues(int id, const double *y, qsizetype count);
+
+    // Appends the same x values to every series in ids. Series that share an
+    // x column keep sharing it instead of each detaching a copy; their y
+    // columns are appended separately.
+    void appendSharedXValues(const QList<int> &ids, const double *x, qsizetype count);
+    void removeFirst(int id, qsizetype count);
+    void reserve(int id, qsizetype capacity);
+
+private:
+    struct Series {
+        QString name;
+        QList<double> x;
+        QList<double> y;
+
+        // Window of a mapped file, used instead of x and y while file is set
+        FluentSpan<double> mappedX;
+        FluentSpan<double> mappedY;
+        QSharedPointer<FluentMappedSeriesFile> file;
+    };
+
+    void detach(Series &series);
+
+    QList<Series> m_series;
+    QHash<QString, int> m_ids;
+};
+
+#endif // FLUENTSERIESTABLE_H
@@ -0,0 +1,216 @@
+#include "fluenttopnselector.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// Ranking value: non-finite values go below every finite one
+double rankValue(double value)
+{
+    return std::isfinite(value) ? value : -std::numeric_limits<double>::infinity();
+}
+
+// Share of the sum of the others, as much as a pie can draw of it
+double weight(double value)
+{
+    return std::isfinite(value) && value > 0.0 ? value : 0.0;
+}
+
+bool sameValue(double a, double b)
+{
+    return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+} // namespace
+
+FluentTopNSelector::FluentTopNSelector()
+    : m_count(0)
+    , m_restSum(0.0)
+    , m_restMax(-1)
+    , m_updatesSinceSum(0)
+{
+}
+
+void FluentTopNSelector::clear()
+{
+    m_values.clear();
+    m_selected.clear();
+    m_top.clear();
+    m_count = 0;
+    m_restSum = 0.0;
+    m_restMax = -1;
+    m_updatesSinceSum = 0;
+}
+
+void FluentTopNSelector::reset(const double *values, qsizetype size, int count)
+{
+    clear();
+    if (size <= 0) return;
+
+    m_values.resize(size);
+    std::copy(values, values + size, m_values.begin());
+    m_selected.fill(false, size);
+    m_count = int(qBound(qsizetype(0), qsizetype(count), size));
+
+    QList<qsizetype> indices(size);
+    for (qsizetype i = 0; i < size; ++i) {
+        indices[i] = i;
+    }
+
+    // Partition around the count-th largest, then order only the selection
+    const auto above = [this](qsizetype a, qsizetype b) { return ranksAbove(a, b); };
+    std::nth_element(indices.begin(), indices.begin() + m_count, indices.end(), above);
+    std::sort(indices.begin(), indices.begin() + m_count, above);
+
+    m_top = indices.mid(0, m_count);
+    for (qsizetype index : std::as_const(m_top)) {
+        m_selected[index] = true;
+    }
+    resum();
+}
+
+void FluentTopNSelector::sync(const double *values, qsizetype size, int count)
+{
+    if (size != m_values.size() || qBound(qsizetype(0), qsizetype(count), size) != m_count) {
+        reset(values, size, count);
+        return;
+    }
+
+    qsizetype changed = 0;
+    for (qsizetype i = 0; i < size; ++i) {
+        if (!sameValue(values[i], m_values.at(i))) ++changed;
+    }
+
+    // Past a quarter of the values changing one by one costs more than
+    // selecting again
+    if (changed > size / 4) {
+        reset(values, size, count);
+        return;
+    }
+    for (qsizetype i = 0; changed > 0 && i < size; ++i) {
+        if (sameValue(values[i], m_values.at(i))) continue;
+        setValue(i, values[i]);
+        --changed;
+    }
+}
+
+void FluentTopNSelector::setValue(qsizetype index, double value)
+{
+    if (index < 0 || index >= m_values.size()) return;
+
+    const double previous = m_values.at(index);
+    if (sameValue(previous, value)) return;
+
+    if (m_selected.at(index)) {
+        m_top.removeOne(index);
+        m_values[index] = value;
+        insertTop(index);
+
+        // A selected value that fell may now rank below the best of the rest
+        if (m_top.constLast() == index && m_top.size() < m_values.size()) {
+            const qsizetype best = restMax();
+            if (ranksAbove(best, index)) {
+                promote(best);
+                m_restMax = -1;
+            }
+        }
+    } else {
+        m_values[index] = value;
+        m_restSum += weight(value) - weight(previous);
+
+        if (m_restMax == index) {
+            if (rankValue(value) < rankValue(previous)) m_restMax = -1;
+        } else if (m_restMax >= 0 && ranksAbove(index, m_restMax)) {
+            m_restMax = index;
+        }
+
+        // The value that drops out ranked above everything left in the rest
+        if (!m_top.isEmpty() && ranksAbove(index, m_top.constLast())) {
+            promote(index);
+        }
+    }
+
+    // Adding and subtracting drifts, so the sum is redone every size updates
+    if (++m_updatesSinceSum >= m_values.size()) resum();
+}
+
+qsizetype FluentTopNSelector::size() const
+{
+    return m_values.size();
+}
+
+int FluentTopNSelector::count() const
+{
+    return m_count;
+}
+
+const QList<qsizetype> &FluentTopNSelector::top() const
+{
+    return m_top;
+}
+
+QList<qsizetype> FluentTopNSelector::rest() const
+{
+    QList<qsizetype> indices;
+    indices.reserve(m_values.size() - m_top.size());
+    for (qsizetype i = 0; i < m_values.size(); ++i) {
+        if (!m_selected.at(i)) indices.append(i);
+    }
+    return indices;
+}
+
+double FluentTopNSelector::restSum() const
+{
+    return m_restSum;
+}
+
+bool FluentTopNSelector::ranksAbove(qsizetype a, qsizetype b) const
+{
+    const double rankA = rankValue(m_values.at(a));
+    const double rankB = rankValue(m_values.at(b));
+    return rankA > rankB || (rankA == rankB && a < b);
+}
+
+void FluentTopNSelector::insertTop(qsizetype index)
+{
+    const auto position = std::upper_bound(m_top.begin(), m_top.end(), index,
+                                           [this](qsizetype a, qsizetype b) { return ranksAbove(a, b); });
+    m_top.insert(position - m_top.begin(), index);
+}
+
+// Swaps index from the rest with the smallest selected value, which then
+// becomes the largest value of the rest
+void FluentTopNSelector::promote(qsizetype index)
+{
+    const qsizetype demoted = m_top.takeLast();
+    m_selected[demoted] = false;
+    m_restSum += weight(m_values.at(demoted));
+
+    m_selected[index] = true;
+    m_restSum -= weight(m_values.at(index));
+    insertTop(index);
+
+    m_restMax = demoted;
+}
+
+qsizetype FluentTopNSelector::restMax()
+{
+    if (m_restMax >= 0) return m_restMax;
+
+    for (qsizetype i = 0; i < m_values.size(); ++i) {
+        if (m_selected.at(i)) continue;
+        if (m_restMax < 0 || ranksAbove(i, m_restMax)) m_restMax = i;
+    }
+    return m_restMax;
+}
+
+void FluentTopNSelector::resum()
+{
+    m_restSum = 0.0;
+    for (qsizetype i = 0; i < m_values.size(); ++i) {
+        if (!m_selected.at(i)) m_restSum += weight(m_values.at(i));
+    }
+    m_updatesSinceSum = 0;
+}
@@ -0,0 +1,56 @@
+#ifndef FLUENTTOPNSELECTOR_H
+#define FLUENTTOPNSELECTOR_H
+
+#include <QList>
+#include <QtGlobal>
+
+// Keeps the indices of the `count` largest of a list of values, and the sum
+// of the others, up to date as single values change.
+//
+// reset() selects from scratch in O(n) with a selection algorithm and only
+// sorts the selected values. setValue() costs O(count) for the ordered
+// selection; only a selected value dropping below the rest needs an O(n)
+// scan for the largest unselected one, which is otherwise tracked.
+//
+// Non-finite values rank below every finite one. The sum of the others only
+// adds up finite positive values, as a pie draws them.
+class FluentTopNSelector
+{
+public:
+    FluentTopNSelector();
+
+    void clear();
+    void reset(const double *values, qsizetype size, int count);
+
+    // Updates the selection to values, one setValue() per changed value, or
+    // with reset() when the size or count changed or most values did
+    void sync(const double *values, qsizetype size, int count);
+    void setValue(qsizetype index, double value);
+
+    qsizetype size() const;
+    int count() const;
+
+    // Selected indices, largest value first
+    const QList<qsizetype> &top() const;
+
+    // The indices not selected, in index order, and the sum of their values
+    QList<qsizetype> rest() const;
+    double restSum() const;
+
+private:
+    bool ranksAbove(qsizetype a, qsizetype b) const;
+    void insertTop(qsizetype index);
+    void promote(qsizetype index);
+    qsizetype restMax();
+    void resum();
+
+    QList<double> m_values;
+    QList<bool> m_selected;
+    QList<qsizetype> m_top;     // largest first
+    int m_count;
+    double m_restSum;
+    qsizetype m_restMax;        // largest unselected index, -1 when unknown
+    qsizetype m_updatesSinceSum;
+};
+
+#endif // FLUENTTOPNSELECTOR_H